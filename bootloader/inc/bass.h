@@ -3,7 +3,11 @@
 #define __COMPUTER__PROGRAM_H__
 
 #include <stdint.h>
+#include "computer.h"
 #define MAX_BASS_SIZE 768
 extern const uint8_t instructions[];
 
+// The same program compiled to C by tools/basspiler.py (make BASS_NATIVE=1)
+uint8_t bass_native(computer_state *state);
+
 #endif
@@ -2,6 +2,44 @@
 #define __BOOTLOADER_BF_H__
 
 #include <stdint.h>
+
+#define TAPE_SIZE 50
+
+/*
+ * The key program compiled by tools/bfcompiler.py (src/bf_program.c)
+ *
+ * a is the count of a run, the cell of BF_SET or the step of a scan, b is
+ * where a bracket jumps to. BF_MOVE and BF_MOVE_AT are followed by a
+ * BF_TARGET for each cell they add to, a being the amount per unit of the
+ * counter and b the cell's offset from it, and then by the loop they replace,
+ * which runs when they cannot.
+ */
+enum BF_OP {
+    BF_END,
+    BF_RIGHT,
+    BF_LEFT,
+    BF_ADD,
+    BF_SET,
+    BF_UP,
+    BF_DOWN,
+    BF_OPEN,
+    BF_CLOSE,
+    BF_CLEAR,
+    BF_SCAN_RIGHT,
+    BF_SCAN_LEFT,
+    BF_MOVE,
+    BF_MOVE_AT,
+    BF_TARGET
+};
+
+typedef struct bf_instruction {
+    uint8_t op;
+    uint8_t a;
+    int16_t b;
+} bf_instruction;
+
+extern const bf_instruction bf_program[];
+
 void bf_decrypt(uint8_t *encrypted_arr, uint8_t size);
 void load_tape(unsigned char *tape, uint8_t *encrypted_arr, uint8_t size);
 void save_tape(unsigned char *tape, uint8_t *encrypted_arr, uint8_t size);
@@ -17,6 +17,9 @@
 #define FLASH_PAGESIZE 1024
 #define FLASH_WRITESIZE 4
 
+// Firmware bytes decrypted at a time while booting, each chunk goes through the Dumb Bass program before the next
+#define FW_DECODE_CHUNK 256
+
 // Protocol Constants
 #define OK ((unsigned char)0x00)
 #define ERROR ((unsigned char)0x01)
@@ -24,6 +27,40 @@
 #define BOOT ((unsigned char)'B')
 #define FRAME ((unsigned char)'F')
 #define BASS ((unsigned char)'T')
+#define WINDOW ((unsigned char)'W')
+#define ACK ((unsigned char)'A')
+#define BAUD ((unsigned char)'R')
+#define PROFILE ((unsigned char)'P')
+
+// Most data frames the updater may have in flight during a windowed update
+// One frame is flashed while the next one is received, so this is the number of receive buffers
+#define UPDATE_WINDOW_MAX 2
+
+// System clock while the bootloader runs, 80MHz from the PLL off the 16MHz crystal
+#define BOOT_CLOCK_CONFIG (SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ)
+// Clock handed to the firmware, the reset state of 16MHz PIOSC with the PLL and main oscillator off
+#define FW_CLOCK_CONFIG (SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_INT | SYSCTL_XTAL_16MHZ | SYSCTL_MAIN_OSC_DIS)
+
+// Boots between full ed25519 checks of the firmware, the boot tag in the vault covers the ones in between
+// 1 checks the signature on every boot
+#ifndef BOOT_FULL_VERIFY_INTERVAL
+#define BOOT_FULL_VERIFY_INTERVAL 16
+#endif
+// The boot counter is stored XORed with this next to itself, anything else means it was lost
+#define BOOT_COUNT_MAGIC 0xB0075C0D
+
+// Fastest baud rate the updater may negotiate, UART0 runs off the 16MHz PIOSC
+#define BAUD_MAX 1000000
+// Probe frame sent by the updater at the new baud rate, data bytes count up from zero
+#define BAUD_PROBE_LEN 16
+// Milliseconds to wait for each step of the probe before falling back to UART_DEFAULT_BAUD
+#define BAUD_PROBE_TIMEOUT 500
+
+// Words programmed between polls of the frame receiver while flashing in windowed mode
+// The CPU stalls while each word is programmed, so the RX interrupt only drains the FIFO between words.
+// A word takes at most 50us, under 5 byte times at 921600 baud, which the 16 byte FIFO covers.
+// 64 words are at most 3.2ms, about 300 byte times, well below UART_RX_RING_SIZE until the next poll.
+#define FLASH_POLL_WORDS 64
 
 // Return messages
 #define VERIFY_SUCCESS 0
@@ -2,10 +2,39 @@
 #define __BOOTLOADER__BUTILS_H__
 #include <stdint.h>
 #include <stdbool.h>
+#include "computer.h"
+
+// States of the non-blocking frame receiver
+enum FRAME_RX_STATE {
+	FRAME_RX_WAIT,
+	FRAME_RX_SIZE_LO,
+	FRAME_RX_SIZE_HI,
+	FRAME_RX_DATA,
+	FRAME_RX_CRC_LO,
+	FRAME_RX_CRC_HI,
+	FRAME_RX_DONE
+};
+
+// Frame being received in the background of other work (windowed updates)
+typedef struct frame_rx {
+	uint8_t *buffer;
+	enum FRAME_RX_STATE state;
+	uint32_t received;
+	uint16_t size;
+	uint16_t checksum;
+} frame_rx;
+
 long program_flash(void* page_addr, unsigned char * data, unsigned int data_len);
+long program_flash_erased(void* page_addr, unsigned char * data, unsigned int data_len, frame_rx *rx);
+long erase_flash_blocks(uint32_t first_block, uint32_t blocks);
 uint16_t read_short(void);
 uint32_t read_frame(uint8_t *buffer);
+uint32_t read_frame_body(uint8_t *buffer);
+void frame_rx_start(frame_rx *rx, uint8_t *buffer);
+bool frame_rx_poll(frame_rx *rx);
+uint32_t frame_rx_finish(frame_rx *rx);
+bool negotiate_baud(uint32_t baud);
 bool verify_checksum(uint16_t given_checksum, uint8_t *data, uint32_t len);
 void uart_write_hex_bytes(uint8_t uart, uint8_t *start, uint32_t len);
-void bass_crypt(uint8_t * buf, uint32_t len);
+void bass_crypt(uint8_t *out, uint32_t len, computer_refill refill, void *context);
 #endif
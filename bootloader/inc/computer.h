@@ -16,6 +16,19 @@
 //#define COMP_RF_MASK 0b00100000
 #define COMP_RF_MASK 0x20
 
+// Register file indices, the masks above are decoded into these when the program is loaded
+#define COMP_RA 0
+#define COMP_RB 1
+#define COMP_RC 2
+#define COMP_RD 3
+#define COMP_RE 4
+#define COMP_RF 5
+#define COMP_REGS 6
+#define COMP_BAD_REG 0xFF
+
+// ip is 8 bits, so a program is always 256 instruction slots
+#define COMP_PROGRAM_SLOTS 256
+
 //hex doesn't count up like this but whatever
 #define COMP_MOV_CODE 0x39
 
@@ -39,6 +52,10 @@
 #define COMP_SYS_WRITE	0x10
 #define COMP_SYS_READ	0x20
 #define COMP_SYS_EXIT	0x30
+// Block syscalls, a and b are memory addresses and rb is the length in bytes
+#define COMP_SYS_WRITE_BLOCK	0x11
+#define COMP_SYS_READ_BLOCK	0x21
+#define COMP_SYS_XOR_BLOCK	0x40
 
 #define COMP_FLAG_SIGN_SHIFT 0
 #define COMP_FLAG_CARRY_SHIFT 1
@@ -51,15 +68,37 @@ typedef struct _ins {
 	uint8_t b;
 } computer_instruction;
 
+struct _comp;
+
+// Every handler advances ip itself and returns true when the program ends
+typedef bool (*computer_op)(struct _comp *state, uint8_t a, uint8_t b);
+
+// Points sys_read_buffer at more input once it runs out, returns false when there is none left
+typedef bool (*computer_refill)(struct _comp *state);
+
+#define COMP_LOOP_NONE	0
+#define COMP_LOOP_BLOCK	1
+#define COMP_LOOP_BYTE	2
+
+// A loop that XORs the buffer with a periodic key, found by computer_match_xor_loop
+typedef struct _xor_loop {
+	uint8_t kind;
+	computer_op op;		// what the loop's first slot decoded to
+	// COMP_LOOP_BLOCK: sbr/sbx/sbw of count bytes at addr with the key at key
+	uint8_t count;
+	uint8_t addr;
+	uint8_t key;
+	// COMP_LOOP_BYTE: sr, xor with memory[index & mask], sw
+	uint8_t index;
+	uint8_t step;
+	uint8_t mask_reg;
+	uint8_t mask;
+} computer_xor_loop;
+
 typedef struct _comp {
 	uint8_t ip;
 	uint8_t fl;
-	uint8_t ra;
-	uint8_t rb;
-	uint8_t rc;
-	uint8_t rd;
-	uint8_t re;
-	uint8_t rf;
+	uint8_t r[COMP_REGS];
 	// Care must be taken to ensure this buffer is 256 instructions
 	// If we make the ip refer to instruction rather than offset we can fit 256 instructions
 	// versus 256 // 3 = 85 instructions
@@ -68,29 +107,46 @@ typedef struct _comp {
 	uint8_t *sys_read_buffer;
 	uint32_t sys_read_remaining;
 	uint32_t sys_write_remaining;
+	// Optional, lets the input arrive in chunks instead of one buffer
+	computer_refill sys_read_refill;
+	void *sys_read_context;
 	uint8_t memory[256];
+	computer_xor_loop xor_loop;
 } computer_state;
 
+// Register operands are indices into r, other operands are copied as is
+typedef struct _decoded_ins {
+	computer_op op;
+	uint8_t a;
+	uint8_t b;
+} computer_decoded_instruction;
+
 // Returns exit code after SYS exit
 uint8_t computer_interpret_program(computer_state *);
-uint8_t computer_read_reg(computer_state* state, uint8_t reg_num);
-void computer_write_reg(computer_state* state, uint8_t reg_num, uint8_t value);
-
-void computer_badins(void);
-void computer_mov(computer_state *state, uint8_t a, uint8_t b);
-void computer_add(computer_state *state, uint8_t a, uint8_t b);
-void computer_sub(computer_state *state, uint8_t a, uint8_t b);
-void computer_imm(computer_state *state, uint8_t a, uint8_t b);
-void computer_cmp(computer_state *state, uint8_t a, uint8_t b);
-void computer_stm(computer_state *state, uint8_t a, uint8_t b);
-void computer_ldm(computer_state *state, uint8_t a, uint8_t b);
+bool computer_read_more(computer_state *state);
+void computer_decode_program(const computer_instruction *instructions, computer_decoded_instruction *program);
+void computer_match_xor_loop(computer_state *state, computer_decoded_instruction *program);
+void computer_xor_stream(uint8_t *buf, uint32_t len, const uint8_t *key, uint32_t period, uint32_t phase);
+uint8_t computer_reg_index(uint8_t reg_mask);
+uint8_t computer_cmp_flags(uint8_t ra, uint8_t rb);
+
+bool computer_badins(computer_state *state, uint8_t a, uint8_t b);
+bool computer_badreg(computer_state *state, uint8_t a, uint8_t b);
+bool computer_run_xor_loop(computer_state *state, uint8_t a, uint8_t b);
+bool computer_mov(computer_state *state, uint8_t a, uint8_t b);
+bool computer_add(computer_state *state, uint8_t a, uint8_t b);
+bool computer_sub(computer_state *state, uint8_t a, uint8_t b);
+bool computer_imm(computer_state *state, uint8_t a, uint8_t b);
+bool computer_cmp(computer_state *state, uint8_t a, uint8_t b);
+bool computer_stm(computer_state *state, uint8_t a, uint8_t b);
+bool computer_ldm(computer_state *state, uint8_t a, uint8_t b);
 bool computer_sys(computer_state *state, uint8_t a, uint8_t b);
-void computer_jmp(computer_state *state, uint8_t a, uint8_t b);
-void computer_jne(computer_state *state, uint8_t a, uint8_t b);
-void computer_jlt(computer_state *state, uint8_t a, uint8_t b);
-void computer_and(computer_state *state, uint8_t a, uint8_t b);
-void computer_not(computer_state *state, uint8_t a, uint8_t b);
-void computer_orr(computer_state *state, uint8_t a, uint8_t b);
-void computer_xor(computer_state *state, uint8_t a, uint8_t b);
+bool computer_jmp(computer_state *state, uint8_t a, uint8_t b);
+bool computer_jne(computer_state *state, uint8_t a, uint8_t b);
+bool computer_jlt(computer_state *state, uint8_t a, uint8_t b);
+bool computer_and(computer_state *state, uint8_t a, uint8_t b);
+bool computer_not(computer_state *state, uint8_t a, uint8_t b);
+bool computer_orr(computer_state *state, uint8_t a, uint8_t b);
+bool computer_xor(computer_state *state, uint8_t a, uint8_t b);
 
 #endif
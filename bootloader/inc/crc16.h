@@ -0,0 +1,9 @@
+#ifndef __BOOTLOADER_CRC16_H__
+#define __BOOTLOADER_CRC16_H__
+#include <stdint.h>
+
+// CRC-16/IBM of a frame, matches ROM_Crc16 and ssb.crc16
+// Pass 0 as crc for the first chunk and the previous result for the next
+uint16_t crc16(uint16_t crc, const uint8_t *data, uint32_t len);
+
+#endif
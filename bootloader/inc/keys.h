@@ -0,0 +1,41 @@
+#ifndef __BOOTLOADER_KEYS_H__
+#define __BOOTLOADER_KEYS_H__
+#include <stdint.h>
+
+#include "wolfssl/wolfcrypt/settings.h"
+#include "wolfssl/wolfcrypt/aes.h"
+#include "wolfssl/wolfcrypt/sha256.h"
+
+/*
+ * The keys, decoded once at startup
+ *
+ * keys_setup reads the secrets from EEPROM, hides the block, runs bf_decrypt
+ * over them and keeps the AES key schedule and the HMAC midstates in the .keys
+ * section. The raw keys are not kept. Updates and boots copy what they need
+ * with keys_aes and keys_hmac instead of expanding the keys again.
+ *
+ * HMAC-SHA256 is SHA256(key ^ opad || SHA256(key ^ ipad || message)). The
+ * ipad and opad blocks are the same for every MAC, so both are hashed once
+ * and a MAC is
+ *     keys_hmac(&sha);
+ *     wc_Sha256Update(&sha, message, len);
+ *     keys_hmac_final(&sha, mac);
+ * which is two compressions for a short message instead of four.
+ *
+ * keys_wipe zeroes the section, boot_firmware calls it before the firmware is
+ * copied over SRAM.
+ */
+
+typedef struct key_context {
+	Aes aes;	// decrypt key, every copy gets its own IV
+	wc_Sha256 inner;	// key ^ ipad hashed
+	wc_Sha256 outer;	// key ^ opad hashed
+} key_context;
+
+void keys_setup(void);
+void keys_aes(Aes *aes, const uint8_t *iv);
+int keys_hmac(wc_Sha256 *sha);
+int keys_hmac_final(wc_Sha256 *sha, uint8_t *mac);
+void keys_wipe(void);
+
+#endif
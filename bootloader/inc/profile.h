@@ -0,0 +1,79 @@
+#ifndef __BOOTLOADER_PROFILE_H__
+#define __BOOTLOADER_PROFILE_H__
+#include <stdint.h>
+
+/*
+ * Cycle counts for the bootloader's hot paths (make PROFILE=1)
+ *
+ * A region is timed with
+ *     uint32_t start = profile_start();
+ *     ...
+ *     profile_end(PROFILE_PROGRAM_FLASH, start);
+ * and the count, min, max and total cycles of every region are dumped with the
+ * PROFILE command. Without BOOTLOADER_PROFILE both calls compile to nothing
+ * and the dump reports zero cycles per second.
+ *
+ * The table lives in .noinit so it survives SysCtlReset, but booting copies
+ * the firmware over it, so boot_firmware dumps it before the copy.
+ */
+
+enum PROFILE_REGION {
+	PROFILE_READ_FRAME,
+	PROFILE_VERIFY_CHECKSUM,
+	PROFILE_PROGRAM_FLASH,
+	PROFILE_AES_CTR,
+	PROFILE_VERIFY_HMAC,
+	PROFILE_BOOT_TAG,
+	PROFILE_ED25519_VERIFY,
+	PROFILE_BF_DECRYPT,
+	PROFILE_BASS_CRYPT,
+	PROFILE_COPY_FW_TO_RAM,
+	PROFILE_REGIONS
+};
+
+typedef struct profile_entry {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+} profile_entry;
+
+void profile_dump(uint8_t uart);
+
+#ifdef BOOTLOADER_PROFILE
+
+// Cortex-M4 DWT cycle counter, enabled by profile_init
+#define PROFILE_DEMCR (*((volatile uint32_t *) 0xE000EDFC))
+#define PROFILE_DEMCR_TRCENA 0x01000000
+#define PROFILE_DWT_CTRL (*((volatile uint32_t *) 0xE0001000))
+#define PROFILE_DWT_CTRL_CYCCNTENA 0x00000001
+#define PROFILE_DWT_CYCCNT (*((volatile uint32_t *) 0xE0001004))
+
+void profile_init(void);
+void profile_end(enum PROFILE_REGION region, uint32_t start);
+void profile_dump_start(uint8_t uart);
+void profile_dump_sample(uint8_t uart, enum PROFILE_REGION region, uint32_t cycles);
+
+#ifdef BOOTLOADER_HOST
+// No cycle counter on the host simulator, it counts nanoseconds instead
+uint32_t profile_start(void);
+#else
+static inline uint32_t profile_start(void) {
+	return PROFILE_DWT_CYCCNT;
+}
+#endif
+
+#else
+
+static inline void profile_init(void) {
+}
+
+static inline uint32_t profile_start(void) {
+	return 0;
+}
+
+static inline void profile_end(enum PROFILE_REGION region, uint32_t start) {
+}
+
+#endif
+#endif
@@ -1,6 +1,7 @@
 #ifndef __BOOTLOADER_STORAGE_H__
 #define __BOOTLOADER_STORAGE_H__
 #include <stdint.h>
+#include "secrets.h"
 /*
  * Partition layout:
  * | Iv Metadata | Message | ...Firmware... | Signature |
@@ -25,5 +26,7 @@ typedef struct vault_struct {
 	uint32_t fw_version;
 	uint32_t fw_length;
 	uint32_t message_len;
+	// HMAC over the trusted partition from the last full signature check
+	uint8_t boot_tag[SECRETS_HASH_LENGTH];
 } vault_struct;
 #endif
@@ -84,6 +84,33 @@ extern "C" {
     #define WOLFSSL_SP_ARM_CORTEX_M_ASM
 #endif
 
+/* ------------------------------------------------------------------------- */
+/* Tuned Crypto Profile (make FAST_CRYPTO=1) */
+/* ------------------------------------------------------------------------- */
+/* The bootloader only uses ed25519 verify, HMAC-SHA256 and AES-CTR. This
+ * profile runs the curve25519/ed25519 field math, SHA-256, SHA-512 and AES on
+ * the Thumb-2 assembly in wolfcrypt/src/port/arm and drops RSA and DH, which
+ * nothing calls. SP math above only speeds up RSA, DH and ECC, so it stays off.
+ * wolfSSL has to be rebuilt when switching profiles. */
+#ifdef BOOTLOADER_FAST_CRYPTO
+    #undef  WOLFSSL_ARMASM
+    #define WOLFSSL_ARMASM
+    #undef  WOLFSSL_ARMASM_THUMB2
+    #define WOLFSSL_ARMASM_THUMB2
+
+    /* Inline assembly in C files instead of the .S files */
+    #undef  WOLFSSL_ARMASM_INLINE
+    #define WOLFSSL_ARMASM_INLINE
+
+    /* Cortex-M4 has no crypto extension or NEON */
+    #undef  WOLFSSL_ARMASM_NO_HW_CRYPTO
+    #define WOLFSSL_ARMASM_NO_HW_CRYPTO
+    #undef  WOLFSSL_ARMASM_NO_NEON
+    #define WOLFSSL_ARMASM_NO_NEON
+    #undef  WOLFSSL_ARM_ARCH
+    #define WOLFSSL_ARM_ARCH 7
+#endif
+
 /* ------------------------------------------------------------------------- */
 /* FIPS - Requires eval or license from wolfSSL */
 /* ------------------------------------------------------------------------- */
@@ -119,7 +146,7 @@ extern "C" {
 /* ------------------------------------------------------------------------- */
 /* RSA */
 #undef NO_RSA
-#if 1
+#ifndef BOOTLOADER_FAST_CRYPTO
     #ifdef USE_FAST_MATH
         /* Maximum math bits (Max RSA key bits * 2) */
         #undef  FP_MAX_BITS
@@ -239,7 +266,7 @@ extern "C" {
 
 /* DH */
 #undef  NO_DH
-#if 1
+#ifndef BOOTLOADER_FAST_CRYPTO
     /* Use table for DH instead of -lm (math) lib dependency */
     #if 0
         #define WOLFSSL_DH_CONST
@@ -312,6 +339,10 @@ extern "C" {
     #define HAVE_CURVE25519
     #define HAVE_ED25519 /* ED25519 Requires SHA512 */
 
+    /* Verify the firmware package frame by frame while it is received */
+    #undef  WOLFSSL_ED25519_STREAMING_VERIFY
+    #define WOLFSSL_ED25519_STREAMING_VERIFY
+
     /* Optionally use small math (less flash usage, but much slower) */
     #if 0
         #define CURVED25519_SMALL
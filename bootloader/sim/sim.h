@@ -0,0 +1,43 @@
+#ifndef __BOOTLOADER_SIM_H__
+#define __BOOTLOADER_SIM_H__
+#include <stdint.h>
+#include <setjmp.h>
+
+/*
+ * Host simulator for the bootloader (make host)
+ *
+ * The bootloader addresses flash and SRAM directly, so the simulator maps
+ * them at the same addresses in the host process:
+ * | 0x00010000 - 0x0003FFFF flash, file backed | 0x20000000 - 0x20007FFF SRAM |
+ * Flash below 0x10000 holds the bootloader itself on the board and can't be
+ * mapped on Linux, the bootloader never reads or writes it.
+ */
+#define SIM_FLASH_BASE 0x00010000
+#define SIM_FLASH_SIZE 0x00040000
+#define SIM_FLASH_PAGE_SIZE 1024
+#define SIM_SRAM_BASE 0x20000000
+#define SIM_SRAM_SIZE 0x00008000
+
+// TM4C123GH6PM EEPROM is 32 blocks of 64 bytes
+#define SIM_EEPROM_SIZE 2048
+#define SIM_EEPROM_BLOCK_SIZE 64
+#define SIM_EEPROM_BLOCKS (SIM_EEPROM_SIZE / SIM_EEPROM_BLOCK_SIZE)
+
+// SysCtlReset jumps back here
+extern jmp_buf sim_reset_jmp;
+
+int sim_init(const char *flash_file, const char *eeprom_file);
+int sim_load_image(const char *image_file);
+void sim_reset_state(void);
+void sim_jump_to_fw(uint32_t sram_start, uint32_t sram_end);
+void sim_set_fw_out(const char *fw_out_file, int exit_on_boot);
+
+// Call timing for the benchmark, see sim_stats.c
+int sim_stats_open(const char *stats_file);
+void sim_stats_reset(void);
+void sim_stats_dump(const char *event);
+
+// Opens the pty behind UART0, implemented in lib/uart/uart_host.c
+int uart_host_open(const char *link);
+
+#endif
@@ -0,0 +1,248 @@
+/*
+ * Host stand-ins for the driverlib calls the bootloader makes
+ * Flash keeps its 1KB erase pages and can only clear bits when programmed,
+ * EEPROM blocks stay hidden until the next reset like on the board.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sim.h"
+
+#include "driverlib/flash.h"
+#include "driverlib/eeprom.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+
+jmp_buf sim_reset_jmp;
+
+static uint8_t *sim_eeprom;
+static uint32_t sim_eeprom_hidden;
+static uint32_t sim_clock = 16000000;
+static const char *sim_fw_out;
+static int sim_exit_on_boot;
+
+// Maps size bytes of file at offset to the fixed address addr, creating the file if needed
+static void *sim_map_file(const char *file, uint32_t file_size, uint32_t offset, void *addr, uint32_t size) {
+	struct stat st;
+	void *p;
+	int fd;
+	int flags = MAP_SHARED;
+
+	fd = open(file, O_RDWR | O_CREAT, 0644);
+	if (fd < 0 || fstat(fd, &st)) {
+		perror(file);
+		return NULL;
+	}
+
+	// New files start out erased
+	if (st.st_size < file_size) {
+		uint8_t erased[SIM_FLASH_PAGE_SIZE];
+		memset(erased, 0xFF, sizeof(erased));
+		lseek(fd, st.st_size, SEEK_SET);
+		for (off_t i = st.st_size; i < file_size; i += sizeof(erased)) {
+			if (write(fd, erased, sizeof(erased)) != sizeof(erased)) {
+				perror(file);
+				close(fd);
+				return NULL;
+			}
+		}
+	}
+
+	if (addr) {
+		flags |= MAP_FIXED_NOREPLACE;
+	}
+	p = mmap(addr, size, PROT_READ | PROT_WRITE, flags, fd, offset);
+	close(fd);
+	if (p == MAP_FAILED || (addr && p != addr)) {
+		fprintf(stderr, "sim: can't map %s at %p\n", file, addr);
+		return NULL;
+	}
+	return p;
+}
+
+int sim_init(const char *flash_file, const char *eeprom_file) {
+	void *sram;
+
+	if (!sim_map_file(flash_file, SIM_FLASH_SIZE, SIM_FLASH_BASE, (void *) SIM_FLASH_BASE, SIM_FLASH_SIZE - SIM_FLASH_BASE)) {
+		return -1;
+	}
+
+	sim_eeprom = sim_map_file(eeprom_file, SIM_EEPROM_SIZE, 0, NULL, SIM_EEPROM_SIZE);
+	if (!sim_eeprom) {
+		return -1;
+	}
+
+	sram = mmap((void *) SIM_SRAM_BASE, SIM_SRAM_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+	if (sram != (void *) SIM_SRAM_BASE) {
+		fprintf(stderr, "sim: can't map SRAM at %p\n", (void *) SIM_SRAM_BASE);
+		return -1;
+	}
+	return 0;
+}
+
+// Programs a binary image (bootloader.bin with its secrets block) into flash at address 0
+int sim_load_image(const char *image_file) {
+	FILE *f = fopen(image_file, "rb");
+	uint8_t page[SIM_FLASH_PAGE_SIZE];
+	uint32_t addr = 0;
+	size_t n;
+
+	if (!f) {
+		perror(image_file);
+		return -1;
+	}
+	while ((n = fread(page, 1, sizeof(page), f)) > 0 && addr < SIM_FLASH_SIZE) {
+		// The bootloader's own blocks are not simulated
+		if (addr >= SIM_FLASH_BASE) {
+			memset(page + n, 0xFF, sizeof(page) - n);
+			memcpy((void *) (uintptr_t) addr, page, sizeof(page));
+		}
+		addr += sizeof(page);
+	}
+	fclose(f);
+	return 0;
+}
+
+// State that a reset clears on the board
+void sim_reset_state(void) {
+	sim_eeprom_hidden = 0;
+	sim_clock = 16000000;
+	memset((void *) SIM_SRAM_BASE, 0, SIM_SRAM_SIZE);
+	sim_stats_reset();
+}
+
+void sim_set_fw_out(const char *fw_out_file, int exit_on_boot) {
+	sim_fw_out = fw_out_file;
+	sim_exit_on_boot = exit_on_boot;
+}
+
+// The firmware can't run on the host, save what would have run and reset instead
+void sim_jump_to_fw(uint32_t sram_start, uint32_t sram_end) {
+	FILE *f;
+
+	sim_stats_dump("jump");
+	fprintf(stderr, "sim: jump to firmware at 0x%08x, stack 0x%08x\n", sram_start, sram_end);
+	if (sim_fw_out) {
+		f = fopen(sim_fw_out, "wb");
+		if (f) {
+			fwrite((void *) SIM_SRAM_BASE, 1, SIM_SRAM_SIZE, f);
+			fclose(f);
+		} else {
+			perror(sim_fw_out);
+		}
+	}
+	if (sim_exit_on_boot) {
+		exit(0);
+	}
+	SysCtlReset();
+}
+
+// ========== Flash ==========
+
+static bool sim_flash_range(uint32_t addr, uint32_t len) {
+	return addr >= SIM_FLASH_BASE && addr + len <= SIM_FLASH_SIZE && addr + len >= addr;
+}
+
+int32_t FlashErase(uint32_t ui32Address) {
+	if ((ui32Address & (SIM_FLASH_PAGE_SIZE - 1)) || !sim_flash_range(ui32Address, SIM_FLASH_PAGE_SIZE)) {
+		return -1;
+	}
+	memset((void *) (uintptr_t) ui32Address, 0xFF, SIM_FLASH_PAGE_SIZE);
+	return 0;
+}
+
+int32_t FlashProgram(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count) {
+	uint8_t *dst = (uint8_t *) (uintptr_t) ui32Address;
+	uint8_t *src = (uint8_t *) pui32Data;
+
+	if ((ui32Address & 3) || (ui32Count & 3) || !sim_flash_range(ui32Address, ui32Count)) {
+		return -1;
+	}
+	// Programming can only clear bits, a second write without an erase ANDs the data together
+	for (uint32_t i = 0; i < ui32Count; i++) {
+		dst[i] &= src[i];
+	}
+	return 0;
+}
+
+// ========== EEPROM ==========
+
+uint32_t EEPROMInit(void) {
+	return EEPROM_INIT_OK;
+}
+
+static bool sim_eeprom_visible(uint32_t addr) {
+	uint32_t block = addr / SIM_EEPROM_BLOCK_SIZE;
+	return !(sim_eeprom_hidden & (1u << block));
+}
+
+// Hidden blocks read as zero
+void EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count) {
+	uint8_t *dst = (uint8_t *) pui32Data;
+
+	for (uint32_t i = 0; i < ui32Count && ui32Address + i < SIM_EEPROM_SIZE; i++) {
+		dst[i] = sim_eeprom_visible(ui32Address + i) ? sim_eeprom[ui32Address + i] : 0;
+	}
+}
+
+uint32_t EEPROMProgram(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count) {
+	uint8_t *src = (uint8_t *) pui32Data;
+
+	if ((ui32Address & 3) || (ui32Count & 3) || ui32Address + ui32Count > SIM_EEPROM_SIZE) {
+		return EEPROM_RC_INVPL;
+	}
+	for (uint32_t i = 0; i < ui32Count; i++) {
+		if (!sim_eeprom_visible(ui32Address + i)) {
+			return EEPROM_RC_NOPERM;
+		}
+	}
+	memcpy(sim_eeprom + ui32Address, src, ui32Count);
+	return 0;
+}
+
+uint32_t EEPROMMassErase(void) {
+	memset(sim_eeprom, 0xFF, SIM_EEPROM_SIZE);
+	return 0;
+}
+
+// Block 0 can't be hidden on the board either
+void EEPROMBlockHide(uint32_t ui32Block) {
+	if (ui32Block && ui32Block < SIM_EEPROM_BLOCKS) {
+		sim_eeprom_hidden |= 1u << ui32Block;
+	}
+}
+
+// ========== System control ==========
+
+void SysCtlReset(void) {
+	sim_stats_dump("reset");
+	longjmp(sim_reset_jmp, 1);
+}
+
+void SysCtlClockSet(uint32_t ui32Config) {
+	sim_clock = (ui32Config & SYSCTL_USE_OSC) == SYSCTL_USE_PLL ? 80000000 : 16000000;
+}
+
+uint32_t SysCtlClockGet(void) {
+	return sim_clock;
+}
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral) {
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral) {
+	return true;
+}
+
+// The pty writes synchronously, nothing is ever left in flight
+bool UARTBusy(uint32_t ui32Base) {
+	return false;
+}
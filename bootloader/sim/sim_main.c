@@ -0,0 +1,81 @@
+/*
+ * Host simulator entry point
+ *
+ * Usage: bootloader_sim [--flash file] [--eeprom file] [--image bootloader.bin]
+ *                       [--uart link] [--fw-out file] [--exit-on-boot]
+ *                       [--stats file]
+ *
+ * --image programs a built bootloader.bin (with the secrets block from
+ * bl_build.py) into the simulated flash so the first boot provisions EEPROM
+ * like a freshly flashed board. Flash and EEPROM persist in their files
+ * between runs. fw_update.py talks to the pty printed at startup or to the
+ * --uart symlink. --stats appends the time spent in CRC, flash, crypto and
+ * UART calls to a file on every reset and jump to the firmware.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+
+// bootloader.c's main, renamed by the host build
+int bootloader_main(void);
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [--flash file] [--eeprom file] [--image bootloader.bin] [--uart link] [--fw-out file] [--exit-on-boot] [--stats file]\n", name);
+	exit(1);
+}
+
+int main(int argc, char **argv) {
+	const char *flash_file = "sim_flash.bin";
+	const char *eeprom_file = "sim_eeprom.bin";
+	const char *image_file = NULL;
+	const char *uart_link = NULL;
+	const char *fw_out = NULL;
+	const char *stats_file = NULL;
+	int exit_on_boot = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--exit-on-boot")) {
+			exit_on_boot = 1;
+		} else if (i + 1 >= argc) {
+			usage(argv[0]);
+		} else if (!strcmp(argv[i], "--flash")) {
+			flash_file = argv[++i];
+		} else if (!strcmp(argv[i], "--eeprom")) {
+			eeprom_file = argv[++i];
+		} else if (!strcmp(argv[i], "--image")) {
+			image_file = argv[++i];
+		} else if (!strcmp(argv[i], "--uart")) {
+			uart_link = argv[++i];
+		} else if (!strcmp(argv[i], "--fw-out")) {
+			fw_out = argv[++i];
+		} else if (!strcmp(argv[i], "--stats")) {
+			stats_file = argv[++i];
+		} else {
+			usage(argv[0]);
+		}
+	}
+
+	if (sim_init(flash_file, eeprom_file)) {
+		return 1;
+	}
+	if (image_file && sim_load_image(image_file)) {
+		return 1;
+	}
+	if (uart_host_open(uart_link)) {
+		return 1;
+	}
+	if (stats_file && sim_stats_open(stats_file)) {
+		return 1;
+	}
+	sim_set_fw_out(fw_out, exit_on_boot);
+
+	// Every SysCtlReset comes back here and boots again
+	setjmp(sim_reset_jmp);
+	sim_reset_state();
+	fprintf(stderr, "sim: reset\n");
+	bootloader_main();
+	return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Call timing for the benchmark (make bench)
+ * The host build links with -Wl,--wrap for the functions below, so every call
+ * from the bootloader goes through a __wrap_ function that times the __real_ one.
+ * Each reset or jump to the firmware appends one line to the --stats file:
+ * event=reset t=<CLOCK_MONOTONIC ns> total=<ns since reset> <category>_calls=.. <category>_ns=..
+ * UART time includes waiting for the updater, so it is time the link was the bottleneck.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "sim.h"
+
+#include "uart/uart.h"
+#include "wolfssl/wolfcrypt/settings.h"
+#include "wolfssl/wolfcrypt/aes.h"
+#include "wolfssl/wolfcrypt/sha256.h"
+#include "wolfssl/wolfcrypt/ed25519.h"
+#include "computer.h"
+
+enum sim_stat {
+	SIM_STAT_CRC,
+	SIM_STAT_FLASH,
+	SIM_STAT_CRYPTO,
+	SIM_STAT_VM,
+	SIM_STAT_UART,
+	SIM_STAT_COUNT
+};
+
+static const char *sim_stat_names[SIM_STAT_COUNT] = {"crc", "flash", "crypto", "vm", "uart"};
+
+static FILE *sim_stats_file;
+static uint64_t sim_stats_start;
+static uint64_t sim_stats_calls[SIM_STAT_COUNT];
+static uint64_t sim_stats_ns[SIM_STAT_COUNT];
+
+static uint64_t sim_stats_now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void sim_stats_add(enum sim_stat stat, uint64_t start) {
+	sim_stats_calls[stat]++;
+	sim_stats_ns[stat] += sim_stats_now() - start;
+}
+
+int sim_stats_open(const char *stats_file) {
+	sim_stats_file = fopen(stats_file, "a");
+	if (!sim_stats_file) {
+		perror(stats_file);
+		return -1;
+	}
+	return 0;
+}
+
+void sim_stats_reset(void) {
+	for (int i = 0; i < SIM_STAT_COUNT; i++) {
+		sim_stats_calls[i] = 0;
+		sim_stats_ns[i] = 0;
+	}
+	sim_stats_start = sim_stats_now();
+}
+
+void sim_stats_dump(const char *event) {
+	uint64_t now = sim_stats_now();
+
+	if (!sim_stats_file) {
+		return;
+	}
+	fprintf(sim_stats_file, "event=%s t=%llu total=%llu", event,
+			(unsigned long long) now, (unsigned long long) (now - sim_stats_start));
+	for (int i = 0; i < SIM_STAT_COUNT; i++) {
+		fprintf(sim_stats_file, " %s_calls=%llu %s_ns=%llu",
+				sim_stat_names[i], (unsigned long long) sim_stats_calls[i],
+				sim_stat_names[i], (unsigned long long) sim_stats_ns[i]);
+	}
+	fprintf(sim_stats_file, "\n");
+	fflush(sim_stats_file);
+}
+
+// Defines __wrap_name, which times __real_name under stat
+#define SIM_TIMED(stat, ret, name, params, args) \
+	ret __real_##name params; \
+	ret __wrap_##name params { \
+		uint64_t start = sim_stats_now(); \
+		ret r = __real_##name args; \
+		sim_stats_add(stat, start); \
+		return r; \
+	}
+
+#define SIM_TIMED_VOID(stat, name, params, args) \
+	void __real_##name params; \
+	void __wrap_##name params { \
+		uint64_t start = sim_stats_now(); \
+		__real_##name args; \
+		sim_stats_add(stat, start); \
+	}
+
+// ========== CRC ==========
+SIM_TIMED(SIM_STAT_CRC, uint16_t, crc16, (uint16_t crc, const uint8_t *data, uint32_t count), (crc, data, count))
+
+// ========== Flash ==========
+SIM_TIMED(SIM_STAT_FLASH, int32_t, FlashErase, (uint32_t address), (address))
+SIM_TIMED(SIM_STAT_FLASH, int32_t, FlashProgram, (uint32_t *data, uint32_t address, uint32_t count), (data, address, count))
+
+// ========== Crypto ==========
+SIM_TIMED(SIM_STAT_CRYPTO, int, wc_AesSetKey, (Aes *aes, const byte *key, word32 len, const byte *iv, int dir), (aes, key, len, iv, dir))
+SIM_TIMED(SIM_STAT_CRYPTO, int, wc_AesCtrEncrypt, (Aes *aes, byte *out, const byte *in, word32 sz), (aes, out, in, sz))
+SIM_TIMED(SIM_STAT_CRYPTO, int, wc_Sha256Update, (wc_Sha256 *sha, const byte *data, word32 len), (sha, data, len))
+SIM_TIMED(SIM_STAT_CRYPTO, int, wc_Sha256Final, (wc_Sha256 *sha, byte *hash), (sha, hash))
+SIM_TIMED(SIM_STAT_CRYPTO, int, wc_ed25519_verify_msg, (const byte *sig, word32 sigLen, const byte *msg, word32 msgLen, int *res, ed25519_key *key), (sig, sigLen, msg, msgLen, res, key))
+SIM_TIMED(SIM_STAT_CRYPTO, int, wc_ed25519_verify_msg_init, (const byte *sig, word32 sigLen, ed25519_key *key, byte type, const byte *context, byte contextLen), (sig, sigLen, key, type, context, contextLen))
+SIM_TIMED(SIM_STAT_CRYPTO, int, wc_ed25519_verify_msg_update, (const byte *msgSegment, word32 msgSegmentLen, ed25519_key *key), (msgSegment, msgSegmentLen, key))
+SIM_TIMED(SIM_STAT_CRYPTO, int, wc_ed25519_verify_msg_final, (const byte *sig, word32 sigLen, int *res, ed25519_key *key), (sig, sigLen, res, key))
+
+// ========== Key and firmware obfuscation ==========
+SIM_TIMED_VOID(SIM_STAT_VM, bf_decrypt, (uint8_t *encrypted_arr, uint8_t size), (encrypted_arr, size))
+
+// bass_crypt decrypts the firmware as it reads it, that time stays under crypto
+void __real_bass_crypt(uint8_t *out, uint32_t len, computer_refill refill, void *context);
+void __wrap_bass_crypt(uint8_t *out, uint32_t len, computer_refill refill, void *context) {
+	uint64_t start = sim_stats_now();
+	uint64_t crypto_ns = sim_stats_ns[SIM_STAT_CRYPTO];
+
+	__real_bass_crypt(out, len, refill, context);
+	sim_stats_add(SIM_STAT_VM, start);
+	sim_stats_ns[SIM_STAT_VM] -= sim_stats_ns[SIM_STAT_CRYPTO] - crypto_ns;
+}
+
+// ========== UART ==========
+SIM_TIMED(SIM_STAT_UART, uint8_t, uart_read, (uint8_t uart, int blocking, int *read), (uart, blocking, read))
+SIM_TIMED(SIM_STAT_UART, uint32_t, uart_read_block, (uint8_t uart, uint8_t *buf, uint32_t len, uint32_t timeout), (uart, buf, len, timeout))
+SIM_TIMED_VOID(SIM_STAT_UART, uart_rx_dma_start, (uint8_t uart, uint8_t *buf, uint32_t len), (uart, buf, len))
+SIM_TIMED(SIM_STAT_UART, bool, uart_rx_dma_done, (uint8_t uart), (uart))
+SIM_TIMED_VOID(SIM_STAT_UART, uart_write, (uint8_t uart, uint32_t data), (uart, data))
+SIM_TIMED_VOID(SIM_STAT_UART, uart_write_str, (uint8_t uart, char *str), (uart, str))
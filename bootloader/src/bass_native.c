@@ -0,0 +1,113 @@
+// Generated by tools/basspiler.py from bananaaa.dumbbass, do not edit
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bass.h"
+#include "computer.h"
+
+uint8_t bass_native(computer_state *state) {
+	uint8_t fl = state->fl;
+	uint8_t ra = state->r[COMP_RA];
+	uint8_t rb = state->r[COMP_RB];
+	uint8_t rc = state->r[COMP_RC];
+	uint8_t rd = state->r[COMP_RD];
+	uint8_t re = state->r[COMP_RE];
+	uint8_t rf = state->r[COMP_RF];
+
+	ra = 0x00;
+	rb = 0x01;
+	rc = 0x62;
+	state->memory[ra] = rc;
+	ra += rb;
+	rc = 0x61;
+	state->memory[ra] = rc;
+	ra += rb;
+	rc = 0x6e;
+	state->memory[ra] = rc;
+	ra += rb;
+	rc = 0x61;
+	state->memory[ra] = rc;
+	ra += rb;
+	rc = 0x6e;
+	state->memory[ra] = rc;
+	ra += rb;
+	rc = 0x61;
+	state->memory[ra] = rc;
+	ra += rb;
+	rc = 0x61;
+	state->memory[ra] = rc;
+	ra += rb;
+	rc = 0x61;
+	state->memory[ra] = rc;
+	rb = 0x08;
+	ra = 0x40;
+	state->r[COMP_RA] = ra;
+	state->r[COMP_RB] = rb;
+	state->ip = 27;
+	if (computer_sys(state, 0x08, 0x00)) {
+		ra = state->r[COMP_RA];
+		goto done;
+	}
+	ra = state->r[COMP_RA];
+	rb = 0x10;
+	ra = 0x40;
+	state->r[COMP_RA] = ra;
+	state->r[COMP_RB] = rb;
+	state->ip = 30;
+	if (computer_sys(state, 0x10, 0x00)) {
+		ra = state->r[COMP_RA];
+		goto done;
+	}
+	ra = state->r[COMP_RA];
+	rb = 0x20;
+	ra = 0x40;
+	state->r[COMP_RA] = ra;
+	state->r[COMP_RB] = rb;
+	state->ip = 33;
+	if (computer_sys(state, 0x20, 0x00)) {
+		ra = state->r[COMP_RA];
+		goto done;
+	}
+	ra = state->r[COMP_RA];
+ins_34:
+	rb = 0x40;
+	ra = 0x21;
+	state->r[COMP_RA] = ra;
+	state->r[COMP_RB] = rb;
+	state->ip = 36;
+	if (computer_sys(state, 0x40, 0x00)) {
+		ra = state->r[COMP_RA];
+		goto done;
+	}
+	ra = state->r[COMP_RA];
+	rb = ra;
+	ra = 0x40;
+	state->r[COMP_RA] = ra;
+	state->r[COMP_RB] = rb;
+	state->ip = 39;
+	if (computer_sys(state, 0x40, 0x00)) {
+		ra = state->r[COMP_RA];
+		goto done;
+	}
+	ra = state->r[COMP_RA];
+	ra = 0x11;
+	state->r[COMP_RA] = ra;
+	state->r[COMP_RB] = rb;
+	state->ip = 41;
+	if (computer_sys(state, 0x40, 0x00)) {
+		ra = state->r[COMP_RA];
+		goto done;
+	}
+	ra = state->r[COMP_RA];
+	goto ins_34;
+
+done:
+	state->fl = fl;
+	state->r[COMP_RA] = ra;
+	state->r[COMP_RB] = rb;
+	state->r[COMP_RC] = rc;
+	state->r[COMP_RD] = rd;
+	state->r[COMP_RE] = re;
+	state->r[COMP_RF] = rf;
+	return ra;
+}
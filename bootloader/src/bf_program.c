@@ -0,0 +1,1151 @@
+// Generated by tools/bfcompiler.py from bf_decrypt.bf, do not edit
+
+#include <stdint.h>
+#include <bf.h>
+
+#if TAPE_SIZE != 50
+#error "bf_program.c was compiled for a different tape size"
+#endif
+
+const bf_instruction bf_program[] = {
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_OPEN, 0, 6},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 3},
+	{BF_RIGHT, 7, 0},
+	{BF_ADD, 53, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 7, 0},
+	{BF_SET, 0, 0},
+	{BF_OPEN, 0, 24},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 22},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 14},
+	{BF_SET, 0, 0},
+	{BF_CLOSE, 0, 12},
+	{BF_ADD, 6, 0},
+	{BF_OPEN, 0, 52},
+	{BF_OPEN, 0, 39},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 37},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 29},
+	{BF_SET, 0, 0},
+	{BF_CLOSE, 0, 27},
+	{BF_RIGHT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 48},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 40},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 26},
+	{BF_SET, 6, 0},
+	{BF_OPEN, 0, 57},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 54},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 4, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 4, 0},
+	{BF_RIGHT, 3, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -2},
+	{BF_OPEN, 0, 70},
+	{BF_LEFT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 62},
+	{BF_SET, 5, 0},
+	{BF_UP, 0, 0},
+	{BF_OPEN, 0, 80},
+	{BF_SET, 4, 0},
+	{BF_UP, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 5, 0},
+	{BF_UP, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 73},
+	{BF_SET, 4, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 2, 0},
+	{BF_SET, 5, 0},
+	{BF_UP, 0, 0},
+	{BF_OPEN, 0, 167},
+	{BF_SET, 1, 0},
+	{BF_OPEN, 0, 104},
+	{BF_RIGHT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 99},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 91},
+	{BF_SET, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 89},
+	{BF_SET, 5, 0},
+	{BF_UP, 0, 0},
+	{BF_OPEN, 0, 114},
+	{BF_SET, 4, 0},
+	{BF_UP, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 5, 0},
+	{BF_UP, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 107},
+	{BF_DOWN, 0, 0},
+	{BF_SET, 2, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 2, 0},
+	{BF_MOVE_AT, 2, 5},
+	{BF_TARGET, 1, -5},
+	{BF_TARGET, 1, -3},
+	{BF_OPEN, 0, 134},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 3, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 123},
+	{BF_SET, 0, 0},
+	{BF_MOVE_AT, 1, 0},
+	{BF_TARGET, 1, 5},
+	{BF_OPEN, 0, 143},
+	{BF_RIGHT, 5, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 135},
+	{BF_RIGHT, 3, 0},
+	{BF_MOVE_AT, 2, 3},
+	{BF_TARGET, 1, -3},
+	{BF_TARGET, 1, -2},
+	{BF_OPEN, 0, 155},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 144},
+	{BF_SET, 0, 0},
+	{BF_MOVE_AT, 1, 0},
+	{BF_TARGET, 1, 3},
+	{BF_OPEN, 0, 164},
+	{BF_RIGHT, 3, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 156},
+	{BF_RIGHT, 5, 0},
+	{BF_UP, 0, 0},
+	{BF_CLOSE, 0, 87},
+	{BF_SET, 1, 0},
+	{BF_OPEN, 0, 184},
+	{BF_RIGHT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 179},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 171},
+	{BF_SET, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 169},
+	{BF_SET, 6, 0},
+	{BF_OPEN, 0, 193},
+	{BF_SET, 2, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 6, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 186},
+	{BF_SET, 3, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_SET, 2, 0},
+	{BF_UP, 0, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 215},
+	{BF_SET, 4, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 3, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 206},
+	{BF_SET, 2, 0},
+	{BF_UP, 0, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 231},
+	{BF_SET, 3, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 4, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 222},
+	{BF_SET, 2, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_OPEN, 0, 249},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 245},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 237},
+	{BF_SET, 2, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 235},
+	{BF_SET, 5, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 321},
+	{BF_SET, 5, 0},
+	{BF_MOVE_AT, 2, 5},
+	{BF_TARGET, 1, -5},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 265},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 5, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 254},
+	{BF_SET, 0, 0},
+	{BF_MOVE_AT, 2, 0},
+	{BF_TARGET, 1, 5},
+	{BF_TARGET, 1, 6},
+	{BF_OPEN, 0, 277},
+	{BF_RIGHT, 5, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 266},
+	{BF_RIGHT, 3, 0},
+	{BF_MOVE_AT, 2, 3},
+	{BF_TARGET, 1, -3},
+	{BF_TARGET, 1, -2},
+	{BF_OPEN, 0, 289},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 278},
+	{BF_SET, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 2},
+	{BF_OPEN, 0, 298},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 290},
+	{BF_SET, 0, 0},
+	{BF_OPEN, 0, 307},
+	{BF_RIGHT, 5, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 300},
+	{BF_RIGHT, 6, 0},
+	{BF_OPEN, 0, 316},
+	{BF_LEFT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_SET, 6, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 309},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_CLOSE, 0, 253},
+	{BF_SET, 1, 0},
+	{BF_ADD, 20, 0},
+	{BF_OPEN, 0, 359},
+	{BF_RIGHT, 6, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 340},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 338},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 330},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 330},
+	{BF_SET, 7, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 354},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 352},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 344},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 344},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 324},
+	{BF_RIGHT, 6, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 380},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 376},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 374},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 366},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 366},
+	{BF_SET, 7, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_CLOSE, 0, 363},
+	{BF_SET, 26, 0},
+	{BF_OPEN, 0, 385},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 382},
+	{BF_LEFT, 2, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 21},
+	{BF_OPEN, 0, 394},
+	{BF_RIGHT, 21, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 21, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 386},
+	{BF_RIGHT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 2, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_RIGHT, 25, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 876},
+	{BF_SET, 27, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_OPEN, 0, 417},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 27, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 410},
+	{BF_SET, 0, 0},
+	{BF_OPEN, 0, 428},
+	{BF_RIGHT, 27, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 2, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 419},
+	{BF_RIGHT, 25, 0},
+	{BF_MOVE_AT, 1, 25},
+	{BF_TARGET, 1, -25},
+	{BF_OPEN, 0, 437},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 25, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 429},
+	{BF_SET, 0, 0},
+	{BF_MOVE_AT, 2, 0},
+	{BF_TARGET, 1, 1},
+	{BF_TARGET, 1, 25},
+	{BF_OPEN, 0, 449},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 24, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 438},
+	{BF_RIGHT, 32, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 460},
+	{BF_SET, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 26, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 453},
+	{BF_SET, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 7, 0},
+	{BF_ADD, 16, 0},
+	{BF_SET, 1, 0},
+	{BF_OPEN, 0, 580},
+	{BF_MOVE, 2, 0},
+	{BF_TARGET, 1, -1},
+	{BF_TARGET, 1, 5},
+	{BF_OPEN, 0, 477},
+	{BF_RIGHT, 5, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 6, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 466},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 486},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 478},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 497},
+	{BF_ADD, 255, 0},
+	{BF_OPEN, 0, 495},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 492},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 490},
+	{BF_LEFT, 2, 0},
+	{BF_OPEN, 0, 502},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 499},
+	{BF_SET, 4, 0},
+	{BF_OPEN, 0, 510},
+	{BF_RIGHT, 4, 0},
+	{BF_UP, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 4, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 504},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 255, 0},
+	{BF_SET, 1, 0},
+	{BF_OPEN, 0, 567},
+	{BF_MOVE_AT, 2, 1},
+	{BF_TARGET, 1, -1},
+	{BF_TARGET, 1, 5},
+	{BF_OPEN, 0, 525},
+	{BF_RIGHT, 5, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 514},
+	{BF_SET, 0, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 534},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 526},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 545},
+	{BF_ADD, 255, 0},
+	{BF_OPEN, 0, 543},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 540},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 538},
+	{BF_LEFT, 2, 0},
+	{BF_OPEN, 0, 550},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 547},
+	{BF_SET, 4, 0},
+	{BF_MOVE_AT, 2, 4},
+	{BF_TARGET, 255, -2},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 562},
+	{BF_SET, 3, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 551},
+	{BF_SET, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 514},
+	{BF_RIGHT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 576},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 568},
+	{BF_RIGHT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 2, 0},
+	{BF_CLOSE, 0, 466},
+	{BF_DOWN, 0, 0},
+	{BF_SET, 8, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_ADD, 8, 0},
+	{BF_RIGHT, 19, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 599},
+	{BF_SET, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 26, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 590},
+	{BF_SET, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_OPEN, 0, 716},
+	{BF_MOVE, 2, 0},
+	{BF_TARGET, 1, -1},
+	{BF_TARGET, 1, 5},
+	{BF_OPEN, 0, 613},
+	{BF_RIGHT, 5, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 6, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 602},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 622},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 614},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 633},
+	{BF_ADD, 255, 0},
+	{BF_OPEN, 0, 631},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 628},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 626},
+	{BF_LEFT, 2, 0},
+	{BF_OPEN, 0, 638},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 635},
+	{BF_SET, 4, 0},
+	{BF_OPEN, 0, 646},
+	{BF_RIGHT, 4, 0},
+	{BF_UP, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 4, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 640},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 255, 0},
+	{BF_SET, 1, 0},
+	{BF_OPEN, 0, 703},
+	{BF_MOVE_AT, 2, 1},
+	{BF_TARGET, 1, -1},
+	{BF_TARGET, 1, 5},
+	{BF_OPEN, 0, 661},
+	{BF_RIGHT, 5, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 650},
+	{BF_SET, 0, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 670},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 662},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 681},
+	{BF_ADD, 255, 0},
+	{BF_OPEN, 0, 679},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 676},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 674},
+	{BF_LEFT, 2, 0},
+	{BF_OPEN, 0, 686},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 683},
+	{BF_SET, 4, 0},
+	{BF_MOVE_AT, 2, 4},
+	{BF_TARGET, 255, -2},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 698},
+	{BF_SET, 3, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 687},
+	{BF_SET, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 650},
+	{BF_RIGHT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 712},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 704},
+	{BF_RIGHT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 2, 0},
+	{BF_CLOSE, 0, 602},
+	{BF_SET, 7, 0},
+	{BF_ADD, 8, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 767},
+	{BF_RIGHT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_OPEN, 0, 732},
+	{BF_SET, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 7, 0},
+	{BF_UP, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 726},
+	{BF_SET, 8, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 8, 0},
+	{BF_OPEN, 0, 743},
+	{BF_SET, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 7, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 8, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 736},
+	{BF_SET, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_OPEN, 0, 750},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_LEFT, 2, 0},
+	{BF_CLOSE, 0, 746},
+	{BF_SET, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_OPEN, 0, 762},
+	{BF_RIGHT, 6, 0},
+	{BF_UP, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 756},
+	{BF_RIGHT, 6, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 723},
+	{BF_ADD, 8, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 840},
+	{BF_RIGHT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_OPEN, 0, 834},
+	{BF_SET, 7, 0},
+	{BF_MOVE, 2, 0},
+	{BF_TARGET, 1, -4},
+	{BF_TARGET, 1, -2},
+	{BF_OPEN, 0, 788},
+	{BF_LEFT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 777},
+	{BF_LEFT, 4, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 4},
+	{BF_OPEN, 0, 797},
+	{BF_RIGHT, 4, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 4, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 789},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_OPEN, 0, 823},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 2, -1},
+	{BF_OPEN, 0, 811},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 2, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 803},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 820},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 812},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 802},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 2},
+	{BF_OPEN, 0, 832},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 824},
+	{BF_SET, 0, 0},
+	{BF_CLOSE, 0, 776},
+	{BF_SET, 7, 0},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLOSE, 0, 773},
+	{BF_SET, 6, 0},
+	{BF_OPEN, 0, 851},
+	{BF_RIGHT, 21, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 6, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 842},
+	{BF_SET, 16, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_LEFT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_RIGHT, 19, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_CLOSE, 0, 406},
+	{BF_SET, 25, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLEAR, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 894},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 892},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 884},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 884},
+	{BF_LEFT, 2, 0},
+	{BF_SCAN_LEFT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_OPEN, 0, 908},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 906},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 898},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 898},
+	{BF_SET, 0, 0},
+	{BF_ADD, 25, 0},
+	{BF_OPEN, 0, 939},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 924},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 922},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 914},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 914},
+	{BF_RIGHT, 1, 0},
+	{BF_OPEN, 0, 936},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 934},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 926},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 926},
+	{BF_SET, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 911},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 947},
+	{BF_SET, 0, 0},
+	{BF_ADD, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_CLOSE, 0, 942},
+	{BF_SET, 0, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_OPEN, 0, 960},
+	{BF_SET, 0, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 953},
+	{BF_SET, 0, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 971},
+	{BF_SET, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_UP, 0, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 964},
+	{BF_SET, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 255, -1},
+	{BF_OPEN, 0, 980},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 972},
+	{BF_RIGHT, 1, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 2},
+	{BF_OPEN, 0, 993},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 2, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 985},
+	{BF_SET, 0, 0},
+	{BF_OPEN, 0, 1038},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 1008},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1000},
+	{BF_SET, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 1021},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_ADD, 1, 0},
+	{BF_SET, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1012},
+	{BF_SET, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 2, 0},
+	{BF_OPEN, 0, 1035},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 1033},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1025},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 1025},
+	{BF_SET, 0, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 995},
+	{BF_RIGHT, 3, 0},
+	{BF_OPEN, 0, 1079},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_OPEN, 0, 1052},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 2, 0},
+	{BF_SCAN_LEFT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1043},
+	{BF_RIGHT, 2, 0},
+	{BF_SCAN_RIGHT, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, 1},
+	{BF_OPEN, 0, 1063},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1055},
+	{BF_LEFT, 1, 0},
+	{BF_SCAN_LEFT, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_OPEN, 0, 1077},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 1075},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1067},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 1067},
+	{BF_SET, 3, 0},
+	{BF_CLOSE, 0, 1040},
+	{BF_RIGHT, 3, 0},
+	{BF_OPEN, 0, 1091},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 1089},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1081},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 1081},
+	{BF_SET, 5, 0},
+	{BF_OPEN, 0, 1103},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 1101},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1093},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 1093},
+	{BF_SET, 4, 0},
+	{BF_OPEN, 0, 1115},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 1113},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1105},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 1105},
+	{BF_SET, 2, 0},
+	{BF_OPEN, 0, 1127},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 1125},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1117},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 1117},
+	{BF_SET, 1, 0},
+	{BF_OPEN, 0, 1139},
+	{BF_MOVE, 1, 0},
+	{BF_TARGET, 1, -1},
+	{BF_OPEN, 0, 1137},
+	{BF_LEFT, 1, 0},
+	{BF_ADD, 1, 0},
+	{BF_RIGHT, 1, 0},
+	{BF_ADD, 255, 0},
+	{BF_CLOSE, 0, 1129},
+	{BF_RIGHT, 1, 0},
+	{BF_CLOSE, 0, 1129},
+	{BF_END, 0, 0},
+};
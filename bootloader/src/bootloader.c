@@ -1,16 +1,23 @@
+#include <stddef.h>
+
 #include "bootloader.h"
 #include "secret_partition.h"
 #include "secrets.h"
 #include "metadata.h"
 #include "storage.h"
 #include "butils.h"
+#include "profile.h"
 #include "user_settings.h"
 #include "public.h"
-#include "bf.h"
+#include "keys.h"
 
 // DUMB BASS !!!!!!
 #include "computer.h"
 
+#ifdef BOOTLOADER_HOST
+#include "sim.h"
+#endif
+
 // Hardware Imports
 #include "inc/hw_memmap.h"    // Peripheral Base Addresses
 #include "inc/hw_types.h"     // Boolean type
@@ -36,7 +43,7 @@
 #include "wolfssl/wolfcrypt/settings.h"
 #include "wolfssl/wolfcrypt/aes.h"
 #include "wolfssl/wolfcrypt/sha.h"
-#include "wolfssl/wolfcrypt/hmac.h"
+#include "wolfssl/wolfcrypt/sha256.h"
 
 #include "wolfssl/wolfcrypt/ed25519.h"
 
@@ -44,8 +51,9 @@
 void update_firmware(void);
 void boot_firmware(void);
 void uart_write_hex_bytes(uint8_t, uint8_t *, uint32_t);
-bool verify_hmac(uint8_t * data, uint32_t data_len, uint8_t * key, uint8_t * test_hash);
-void copy_fw_to_ram(uint32_t *fw_ptr, uint32_t *sram_ptr, uint32_t fw_size, Aes *cipher);
+bool verify_hmac(uint8_t * data, uint32_t data_len, uint8_t * test_hash);
+void compute_boot_tag(uint8_t * tag, uint8_t * package, uint32_t package_len, uint8_t * signature, uint32_t version);
+uint32_t copy_fw_to_ram(uint32_t *fw_ptr, uint32_t *sram_ptr, uint32_t fw_size, Aes *cipher);
 void jump_to_fw(uint32_t sram_start, uint32_t sram_end);
 
 typedef void (*pFunction)(void);
@@ -57,13 +65,33 @@ typedef void (*pFunction)(void);
 
 uint8_t message[READ_BUFFER_SIZE];
 
+// Boots since the last full signature check. Kept in .noinit rather than the vault so a
+// fast boot writes nothing to EEPROM. It survives SysCtlReset, after power on or firmware
+// that overwrote it the check word is wrong and the next boot does the full check
+static struct {
+	uint32_t boots;
+	uint32_t check;
+} boot_count __attribute__((section(".noinit")));
+
+static void boot_count_set(uint32_t boots) {
+	boot_count.boots = boots;
+	boot_count.check = boots ^ BOOT_COUNT_MAGIC;
+}
+
 // FLOW CHART: Initialize import state
 
 
 int main(void) {
 
+	// Run from the PLL, the UARTs stay on PIOSC so their timing does not change
+	SysCtlClockSet(BOOT_CLOCK_CONFIG);
+
 	// Initialze the serail port
     initialize_uarts();
+	// Buffer UART0 input from the RX interrupt so flashing never drops bytes
+	uart_rx_enable(UART0);
+
+	profile_init();
 
 #ifdef SCREW_OVER_MY_BOARD
 	if ((HWREG(0x400FE1D0) & 0x00000003) != 0) {
@@ -97,6 +125,9 @@ int main(void) {
 
 	setup_secrets();
 
+	// Decode the keys before any request so updates and boots start with them ready
+	keys_setup();
+
 	uart_write_str(UART0, "Found no secrets in secret block!, retrieving secrets\n");
 
 	// TODO: Should only read vault decryption keays. Other keys are not needed rn 
@@ -117,25 +148,29 @@ int main(void) {
         } else if (instruction == BOOT) {
 			boot_firmware();
 
-        } 
+        } else if (instruction == PROFILE) {
+			profile_dump(UART0);
+		}
     }
 }
 
 void update_firmware(void) {
 
-	secrets_struct secrets;
-	uint8_t ct_buffer[READ_BUFFER_SIZE];
+	// Two receive buffers so a windowed update can receive one frame while flashing the other
+	uint8_t ct_buffer[UPDATE_WINDOW_MAX][READ_BUFFER_SIZE];
 	uint8_t pt_buffer[READ_BUFFER_SIZE];
 
 	// FLOW CHART: Allocate space for IV + encrypted data + decrypted data
 	uint8_t iv[SECRETS_IV_LEN];
+	uint8_t signature[SECRETS_SIGNATURE_LENGTH];
 
 	// EEPROM/flash results
 	int result = 0;
 	uint32_t size; 						// frame size read in
-	uint32_t package_size;				// Calculate size of package for verification
+	uint32_t start;						// profiled region start
 
 	uint32_t old_version;			 	// version of current firmware
+	uint32_t package_size;				// IV + metadata + message + padded firmware, covered by the boot tag
 
 	uint32_t start_block = 300; 		// current block to write into flash (initialize to write to invalid area)
 	uint32_t flash_block_offset = 0; 	// blocks that have been written to flash (make sure to always update this if you increment write_block)
@@ -146,8 +181,18 @@ void update_firmware(void) {
 	uint32_t addr; 						// for calculating addresses in flash to read/write from
 
 	bool passed; 						// did the metadata pass hmac
+	int verify_result = 0;				// result of the streamed signature check
 	bool ending = false; 				// did we receive a < BUFFER_LENGTH size when reading in firmware?
 
+	uint32_t window = 1;				// frames the updater may have in flight, 1 is the classic stop and wait protocol
+	uint32_t erased_blocks = 0;			// blocks erased ahead of time for a windowed update
+	uint32_t current = 0;				// receive buffer holding the frame being flashed
+	uint8_t seq = 0;					// sequence number of the next windowed acknowledgement
+	frame_rx rx;						// background receiver for windowed updates
+	uint32_t instruction;
+	uint32_t baud;						// baud rate proposed by the updater
+	int read = 0;
+
 										// Useful crypto stuff
 	Aes aes;
 	ed25519_key ed25519;
@@ -155,17 +200,41 @@ void update_firmware(void) {
 
 	vault_struct vault;
 
-	// Read secrets from EEPROM and hide block, preventing further access
-	EEPROMRead((uint32_t *) &secrets, SECRETS_EEPROM_OFFSET, sizeof(secrets));
-	EEPROMBlockHide(EEPROMBlockFromAddr(SECRETS_EEPROM_OFFSET));
-	bf_decrypt(secrets.hmac_key, 16);
-	bf_decrypt(secrets.decrypt_key, 16);
-
 	uart_write_str(UART0, "U");
 
+	// Optional handshake requests come before the metadata frame
+	instruction = uart_read(UART0, BLOCKING, &read);
+	while (instruction != FRAME) {
+		if (instruction == WINDOW) {
+			// Updater asks for a window size, answer with the one we can actually handle
+			window = uart_read(UART0, BLOCKING, &read);
+			if (window == 0) {
+				window = 1;
+			}
+			if (window > UPDATE_WINDOW_MAX) {
+				window = UPDATE_WINDOW_MAX;
+			}
+			uart_write(UART0, WINDOW);
+			uart_write(UART0, window);
+		} else if (instruction == BAUD) {
+			// Updater proposes a faster link, this falls back to the default rate if the probe fails
+			uart_read_block(UART0, (uint8_t *) &baud, 4, UART_WAIT_FOREVER);
+			if (negotiate_baud(baud)) {
+				// If our confirmation was lost the updater went back to the default rate and its
+				// next instruction arrives garbled. Resetting restores the default rate and the
+				// updater starts over once its response times out
+				instruction = uart_read(UART0, BLOCKING, &read);
+				if (instruction != WINDOW && instruction != FRAME) {
+					SysCtlReset();
+				}
+				continue;
+			}
+		}
+		instruction = uart_read(UART0, BLOCKING, &read);
+	}
 
 	// FLOW CHART: Read in IV + metadata chunk into memory
-	size = read_frame(ct_buffer);
+	size = read_frame_body(ct_buffer[0]);
 
 	// New metadata blob points into plaintext buffer
     // Ensure size of frame data is equal to size of a metadata blob 
@@ -177,33 +246,26 @@ void update_firmware(void) {
 	}
 
 	// save iv in global and plaintext
-	memcpy(&iv, ct_buffer, sizeof(new_mb->iv));
-	memcpy(pt_buffer, ct_buffer, sizeof(new_mb->iv));
+	memcpy(&iv, ct_buffer[0], sizeof(new_mb->iv));
+	memcpy(pt_buffer, ct_buffer[0], sizeof(new_mb->iv));
 
 	// setup decryption
-	if (wc_AesInit(&aes, NULL, INVALID_DEVID)) {
-		uart_write_str(UART0, "FATAL cipher error\n");
-		while(UARTBusy(UART0_BASE)){}
-		SysCtlReset();
-	}
-	// Direction for some modes (CFB and CTR) is always AES_ENCRYPTION.
-	if (wc_AesSetKey(&aes, secrets.decrypt_key, sizeof(secrets.decrypt_key), iv, AES_ENCRYPTION)){
-		uart_write_str(UART0, "second FATAL cipher error\n");
-		while(UARTBusy(UART0_BASE)){}
-		SysCtlReset();
-	}
+	keys_aes(&aes, iv);
 
 	// FLOW CHART: update hash function w/encrypted metadata block, verify meta data signature
 	
 
 	// copy in the rest of the unencrypted firmware blob into pt
-	if (wc_AesCtrEncrypt(&aes, pt_buffer + sizeof(new_mb->iv), ct_buffer + sizeof(new_mb->iv), sizeof(metadata_blob) - sizeof(new_mb->iv))) {
+	start = profile_start();
+	result = wc_AesCtrEncrypt(&aes, pt_buffer + sizeof(new_mb->iv), ct_buffer[0] + sizeof(new_mb->iv), sizeof(metadata_blob) - sizeof(new_mb->iv));
+	profile_end(PROFILE_AES_CTR, start);
+	if (result) {
 		uart_write_str(UART0, "Idk how to do the funny unencryption thing /shrug\n");
 		while(UARTBusy(UART0_BASE)){}
 		SysCtlReset();
 	}
 
-	passed = verify_hmac((uint8_t *) &new_mb->metadata, sizeof(new_mb->metadata), secrets.hmac_key, (uint8_t *) &new_mb->hmac);
+	passed = verify_hmac((uint8_t *) &new_mb->metadata, sizeof(new_mb->metadata), (uint8_t *) &new_mb->hmac);
 
 	// FLOW CHART: metadata signature good?
 	if (!passed) {
@@ -251,9 +313,7 @@ void update_firmware(void) {
 		case STORAGE_TRUST_NONE:
 			start_block = STORAGE_PARTA;
 			//new_permissions = STORAGE_TRUST_A;
-			#ifdef DEBUG
 			vault.s = STORAGE_TRUST_A;
-			#endif
 
 			uart_write_str(UART0, "Trust no one\n");
 	}
@@ -299,7 +359,7 @@ void update_firmware(void) {
 	addr = addr + FLASH_PAGESIZE - sizeof(metadata_blob);
 
 	// Write **Encrypted** metadata to flash
-	if (FlashProgram((uint32_t *) ct_buffer, addr, sizeof(metadata_blob))) {
+	if (FlashProgram((uint32_t *) ct_buffer[0], addr, sizeof(metadata_blob))) {
 
 		uart_write_str(UART0, "couldn't write metadata :skull:\n");
 		while(UARTBusy(UART0_BASE)){}
@@ -307,17 +367,89 @@ void update_firmware(void) {
 	}
 	flash_block_offset++;
 
+	if (window > 1) {
+		// A windowed update can't stop for a page erase between frames without dropping bytes,
+		// so erase the message, firmware and signature blocks now while the updater waits for us
+		erased_blocks = new_mb->metadata.fw_length;
+		erased_blocks += SECRETS_ENCRYPTION_BLOCK_LENGTH - (erased_blocks % SECRETS_ENCRYPTION_BLOCK_LENGTH);
+		erased_blocks = (erased_blocks + FLASH_PAGESIZE - 1) >> 10;
+		// message block + firmware blocks + signature block
+		erased_blocks += 2;
+
+		if (flash_block_offset + erased_blocks > STORAGE_PART_SIZE) {
+			uart_write_str(UART0, "no storage :<\n");
+			while(UARTBusy(UART0_BASE)){}
+			SysCtlReset();
+		}
+		if (erase_flash_blocks(start_block + flash_block_offset, erased_blocks)) {
+			uart_write_str(UART0, "couldn't erase flash :sob:\n");
+			while(UARTBusy(UART0_BASE)){}
+			SysCtlReset();
+		}
+	}
+
 	// Acknowledge this frame because it is legitimate, prepare for another frame
 	uart_write_str(UART0, "A");
 	// New_mb is no longer needed
 	new_mb = NULL;
 
+	// ========== SIGNATURE ==========
+
+	// The signature comes before the firmware so the package can be hashed while it is received
+	size = read_frame(ct_buffer[0]);
+	if (size != SECRETS_SIGNATURE_LENGTH) {
+		uart_write_str(UART0, "that is not a signature\n");
+		while(UARTBusy(UART0_BASE)){}
+		SysCtlReset();
+	}
+	memcpy(signature, ct_buffer[0], SECRETS_SIGNATURE_LENGTH);
+
+	uart_write_str(UART0, "Funny asymetric stuff\n");
+
+	// Set up ecc
+	if (wc_ed25519_init(&ed25519)) {
+		uart_write_str(UART0, "No memory for ed25519 key :(\n");
+		while(UARTBusy(UART0_BASE)){}
+		SysCtlReset();
+	}
+
+	// Import a key
+	if (wc_ed25519_import_public_ex(ed25519_public_key, sizeof(ed25519_public_key), &ed25519, true)) {
+		uart_write_str(UART0, "Can't init a key smfh\n");
+		while (UARTBusy(UART0_BASE)) {}
+		SysCtlReset();
+	}
+
+	uart_write_str(UART0, "hey look I have funny ecc key now lmao\n");
+
+	// Signed package starts with the metadata and hmac that are already in flash (the IV is not signed)
+	addr = (start_block << 10) + FLASH_PAGESIZE - sizeof(metadata_blob) + SECRETS_IV_LEN;
+	start = profile_start();
+	result = wc_ed25519_verify_msg_init(signature, SECRETS_SIGNATURE_LENGTH, &ed25519, (byte) Ed25519, NULL, 0) ||
+		wc_ed25519_verify_msg_update((uint8_t *) addr, sizeof(metadata_blob) - SECRETS_IV_LEN, &ed25519);
+	profile_end(PROFILE_ED25519_VERIFY, start);
+	if (result) {
+		uart_write_str(UART0, "smh so bad at math can't even calculate a signature\n");
+		while(UARTBusy(UART0_BASE)){}
+		SysCtlReset();
+	}
+
+	uart_write_str(UART0, "A");
+
 	// ========== FIRMWARE ==========
 
+	if (window > 1) {
+		frame_rx_start(&rx, ct_buffer[current]);
+	}
+
 	// Start reading in message data + other data
 	while (true) {
 		 
-		size = read_frame(ct_buffer);
+		if (window > 1) {
+			size = frame_rx_finish(&rx);
+		} else {
+			size = read_frame(ct_buffer[current]);
+		}
 		
 
 		// FLOW CHART: Size = 0?
@@ -354,11 +486,51 @@ void update_firmware(void) {
 		addr = (start_block + flash_block_offset) << 10;
 		flash_block_offset++;
 
-		// Write to flash
-		program_flash((void *) addr, ct_buffer, size);
-
-		// Acknowledge this block
-		uart_write_str(UART0, "A");
+		if (window > 1) {
+			// Only blocks erased up front may be written, the last one is for the signature
+			if (flash_block_offset > erased_blocks) {
+				uart_write_str(UART0, "more firmware than the metadata said\n");
+				while(UARTBusy(UART0_BASE)){}
+				SysCtlReset();
+			}
+
+			// Start receiving frame k+1 into the other buffer while frame k is flashed
+			frame_rx_start(&rx, ct_buffer[current ^ 1]);
+			if (program_flash_erased((void *) addr, ct_buffer[current], size, &rx)) {
+				uart_write_str(UART0, "couldn't write firmware :skull:\n");
+				while(UARTBusy(UART0_BASE)){}
+				SysCtlReset();
+			}
+			// Hash what actually landed in flash, the next frame keeps arriving meanwhile
+			start = profile_start();
+			result = wc_ed25519_verify_msg_update((uint8_t *) addr, size, &ed25519);
+			profile_end(PROFILE_ED25519_VERIFY, start);
+			if (result) {
+				uart_write_str(UART0, "smh so bad at math can't even calculate a signature\n");
+				while(UARTBusy(UART0_BASE)){}
+				SysCtlReset();
+			}
+
+			// Acknowledge this block with its sequence number
+			uart_write(UART0, ACK);
+			uart_write(UART0, seq);
+			seq++;
+			current ^= 1;
+		} else {
+			// Write to flash
+			program_flash((void *) addr, ct_buffer[current], size);
+			start = profile_start();
+			result = wc_ed25519_verify_msg_update((uint8_t *) addr, size, &ed25519);
+			profile_end(PROFILE_ED25519_VERIFY, start);
+			if (result) {
+				uart_write_str(UART0, "smh so bad at math can't even calculate a signature\n");
+				while(UARTBusy(UART0_BASE)){}
+				SysCtlReset();
+			}
+
+			// Acknowledge this block
+			uart_write_str(UART0, "A");
+		}
 	}
 	// This shouldn't happen but added for redundency
 	if (flash_block_offset >= STORAGE_PART_SIZE) {
@@ -367,40 +539,14 @@ void update_firmware(void) {
 		SysCtlReset();
 	}
 
-	//handle signature :D
-	int read = 0;
-	for (int i = 0; i < SECRETS_SIGNATURE_LENGTH; i++) {
-		ct_buffer[i] = uart_read(UART0, BLOCKING, &read);
-	}
-
-	passed = true;
-	
-	// firmware + 1024 bytes message + metadata
-	uart_write_str(UART0, "Funny asymetric stuff\n");
-
-	// Set up ecc
-	if (wc_ed25519_init(&ed25519)) {
-		uart_write_str(UART0, "No memory for ed25519 key :(\n");
-		while(UARTBusy(UART0_BASE)){}
-		SysCtlReset();
-	}
-
-	// Import a key
-	if (wc_ed25519_import_public_ex(ed25519_public_key, sizeof(ed25519_public_key), &ed25519, true)) {
-		uart_write_str(UART0, "Can't init a key smfh\n");
-		while (UARTBusy(UART0_BASE)) {}
-		SysCtlReset();
-	}
-
-	uart_write_str(UART0, "hey look I have funny ecc key now lmao\n");
-
-	package_size = vault.fw_length + FLASH_PAGESIZE + sizeof(metadata_blob) - SECRETS_IV_LEN;
-	// Padding
-	package_size += SECRETS_ENCRYPTION_BLOCK_LENGTH - (package_size % SECRETS_ENCRYPTION_BLOCK_LENGTH);
+	passed = false;
 
-	addr = (start_block << 10) + FLASH_PAGESIZE - sizeof(metadata_blob) + SECRETS_IV_LEN;
-
-	if (wc_ed25519_verify_msg(ct_buffer, SECRETS_SIGNATURE_LENGTH, (uint8_t *) addr, package_size, (int *) &passed, &ed25519)) {
+	// firmware + 1024 bytes message + metadata were hashed as they were flashed
+	// so only the final check is left
+	start = profile_start();
+	result = wc_ed25519_verify_msg_final(signature, SECRETS_SIGNATURE_LENGTH, &verify_result, &ed25519);
+	profile_end(PROFILE_ED25519_VERIFY, start);
+	if (result) {
 		uart_write_str(UART0, "smh so bad at math can't even calculate a signature\n");
 		while(UARTBusy(UART0_BASE)){}
 		SysCtlReset();
@@ -408,6 +554,7 @@ void update_firmware(void) {
 
 	uart_write_str(UART0, "Finished!\n");
 
+	passed = verify_result == 1;
 	if (passed) {
 		uart_write_str(UART0, "omg you are pro gamer!!!!\n");
 	} else {
@@ -417,7 +564,19 @@ void update_firmware(void) {
 	}
 	addr = (start_block + flash_block_offset) << 10;
 
-	program_flash((void *) addr, ct_buffer, SECRETS_SIGNATURE_LENGTH);
+	if (window > 1) {
+		program_flash_erased((void *) addr, signature, SECRETS_SIGNATURE_LENGTH, NULL);
+	} else {
+		program_flash((void *) addr, signature, SECRETS_SIGNATURE_LENGTH);
+	}
+
+	// The signature was just checked, tag the partition so the next boots can skip the check
+	package_size = vault.fw_length;
+	package_size += SECRETS_ENCRYPTION_BLOCK_LENGTH - (package_size % SECRETS_ENCRYPTION_BLOCK_LENGTH);
+	package_size += FLASH_PAGESIZE + sizeof(metadata_blob);
+	compute_boot_tag(vault.boot_tag, (uint8_t *) ((start_block << 10) + FLASH_PAGESIZE - sizeof(metadata_blob)), \
+			package_size, (uint8_t *) addr, vault.fw_version);
+	boot_count_set(0);
 
 	// Store new vault
 	result = EEPROMProgram((uint32_t *)&vault, SECRETS_VAULT_OFFSET, sizeof(vault));
@@ -439,7 +598,6 @@ void update_firmware(void) {
 void boot_firmware(){
 
 	// Values needed for decryption
-	secrets_struct secrets;
 	uint8_t iv[SECRETS_IV_LEN];
 
 	metadata_blob *mb;
@@ -451,6 +609,10 @@ void boot_firmware(){
 	uint32_t blocks;
 	uint8_t* sig_addr;
 	uint8_t* start_addr;
+	uint8_t tag[SECRETS_HASH_LENGTH];	// boot tag of the partition as it is now
+	int verify_result = 0;
+	int result;
+	uint32_t start;						// profiled region start
 						// Decryption cipher
 	Aes aes;
 	ed25519_key ed25519;
@@ -463,13 +625,6 @@ void boot_firmware(){
 	// Read vault status
 	EEPROMRead((uint32_t *) &vault, SECRETS_VAULT_OFFSET, sizeof(vault));
 
-
-	// Read secrets from EEPROM and hide block, preventing further access
-	EEPROMRead((uint32_t *) &secrets, SECRETS_EEPROM_OFFSET, sizeof(secrets));
-	EEPROMBlockHide(EEPROMBlockFromAddr(SECRETS_EEPROM_OFFSET));
-	bf_decrypt(secrets.hmac_key, 16);
-	bf_decrypt(secrets.decrypt_key, 16);
-
 	if (vault.magic == VAULT_MAGIC) {
 		uart_write_str(UART0, "No corrupted vault :D\n");
 	}
@@ -525,27 +680,18 @@ void boot_firmware(){
 	// mb->iv
     memcpy(iv, mb, SECRETS_IV_LEN);
 
-	// Setup crypto
-	if (wc_AesInit(&aes, NULL, INVALID_DEVID)) {
-		uart_write_str(UART0, "FATAL aes initialization error\n");
-		while(UARTBusy(UART0_BASE)){}
-		SysCtlReset();
-    }
-
-     // Set AES decryption key + IV
-	// Direction for some modes (CFB and CTR) is always AES_ENCRYPTION.
-    if (wc_AesSetKey(&aes, secrets.decrypt_key, sizeof(secrets.decrypt_key), iv, AES_ENCRYPTION)) {
-        uart_write_str(UART0, "FATAL aes key setup error\n");
-		while(UARTBusy(UART0_BASE)){}
-        SysCtlReset();
-    }
+	// Setup crypto with the cached key and this partition's IV
+	keys_aes(&aes, iv);
 
 
 	// Decrypt the metadata
-	if (wc_AesCtrEncrypt(&aes, \
+	start = profile_start();
+	result = wc_AesCtrEncrypt(&aes, \
 				(uint8_t *) &decrypted_metadata.metadata, \
 				((uint8_t *) mb) + SECRETS_IV_LEN,\
-				sizeof(metadata_blob) - SECRETS_IV_LEN)) 
+				sizeof(metadata_blob) - SECRETS_IV_LEN);
+	profile_end(PROFILE_AES_CTR, start);
+	if (result)
 	{
 
         uart_write_str(UART0, "FATAL aes decrypt error\n");
@@ -557,7 +703,10 @@ void boot_firmware(){
 
 	// decrypt + print the message
 	// do NOT use metadata.message_length as the message is always 1024 bytes, message_length is only useful when printing the message
-	if (wc_AesCtrEncrypt(&aes, message, m_addr, FLASH_PAGESIZE)) {
+	start = profile_start();
+	result = wc_AesCtrEncrypt(&aes, message, m_addr, FLASH_PAGESIZE);
+	profile_end(PROFILE_AES_CTR, start);
+	if (result) {
         uart_write_str(UART0, "FATAL aes decrypt error\n");
 		while(UARTBusy(UART0_BASE)){}
 		SysCtlReset();
@@ -575,28 +724,13 @@ void boot_firmware(){
 	}
 	// verify hmac signature of metadata
 	bool passed;
-	passed = verify_hmac((uint8_t *) &decrypted_metadata.metadata, sizeof(decrypted_metadata.metadata), secrets.hmac_key, decrypted_metadata.hmac);
+	passed = verify_hmac((uint8_t *) &decrypted_metadata.metadata, sizeof(decrypted_metadata.metadata), decrypted_metadata.hmac);
 	if (!passed) {
 		uart_write_str(UART0, "Metadata wtf\n");
 		while(UARTBusy(UART0_BASE)){}
 		SysCtlReset();
 	}
 
-	// Setup public keys
-
-	if (wc_ed25519_init(&ed25519)) {
-		uart_write_str(UART0, "No memory for ed25519 key :(\n");
-		while(UARTBusy(UART0_BASE)){}
-		SysCtlReset();
-	}
-
-	// Import a key
-	if (wc_ed25519_import_public_ex(ed25519_public_key, sizeof(ed25519_public_key), &ed25519, true)) {
-		uart_write_str(UART0, "Can't init a key smfh\n");
-		while (UARTBusy(UART0_BASE)) {}
-		SysCtlReset();
-	}
-
 	// Verify hmac signature of all data on boot
 	boot_size = decrypted_metadata.metadata.fw_length;
 	//pad boot_size
@@ -611,10 +745,53 @@ void boot_firmware(){
 	//metadata size + message size + firmware size
 	total_size = boot_size + FLASH_PAGESIZE + sizeof(decrypted_metadata) - sizeof(decrypted_metadata.iv);
 
-	if (wc_ed25519_verify_msg(sig_addr, SECRETS_SIGNATURE_LENGTH, (uint8_t *) start_addr, total_size, (int *) &passed, &ed25519)) {
-		uart_write_str(UART0, "smh so bad at math can't even calculate a signature\n");
-		while(UARTBusy(UART0_BASE)){}
-		SysCtlReset();
+	// Fast path: the partition still matches the tag stored after its last full check
+	compute_boot_tag(tag, (uint8_t *) mb, total_size + sizeof(mb->iv), sig_addr, vault.fw_version);
+	passed = true;
+	for (uint32_t i = 0; i < SECRETS_HASH_LENGTH; i++) {
+		if (tag[i] != vault.boot_tag[i]) {
+			passed = false;
+		}
+	}
+
+	if (boot_count.check != (boot_count.boots ^ BOOT_COUNT_MAGIC)) {
+		boot_count_set(BOOT_FULL_VERIFY_INTERVAL);
+	}
+	boot_count_set(boot_count.boots + 1);
+	if (!passed || boot_count.boots >= BOOT_FULL_VERIFY_INTERVAL) {
+		// Setup public keys
+		if (wc_ed25519_init(&ed25519)) {
+			uart_write_str(UART0, "No memory for ed25519 key :(\n");
+			while(UARTBusy(UART0_BASE)){}
+			SysCtlReset();
+		}
+
+		// Import a key
+		if (wc_ed25519_import_public_ex(ed25519_public_key, sizeof(ed25519_public_key), &ed25519, true)) {
+			uart_write_str(UART0, "Can't init a key smfh\n");
+			while (UARTBusy(UART0_BASE)) {}
+			SysCtlReset();
+		}
+
+		start = profile_start();
+		result = wc_ed25519_verify_msg(sig_addr, SECRETS_SIGNATURE_LENGTH, (uint8_t *) start_addr, total_size, &verify_result, &ed25519);
+		profile_end(PROFILE_ED25519_VERIFY, start);
+		if (result) {
+			uart_write_str(UART0, "smh so bad at math can't even calculate a signature\n");
+			while(UARTBusy(UART0_BASE)){}
+			SysCtlReset();
+		}
+
+		// Start a new interval from what was just checked, passed still says whether the tag matched
+		// so the tag is only written to EEPROM when it changed
+		if (verify_result == 1) {
+			boot_count_set(0);
+			if (!passed) {
+				memcpy(vault.boot_tag, tag, SECRETS_HASH_LENGTH);
+				EEPROMProgram((uint32_t *) &vault.boot_tag, SECRETS_VAULT_OFFSET + offsetof(vault_struct, boot_tag), sizeof(vault.boot_tag));
+			}
+		}
+		passed = verify_result == 1;
 	}
 
 
@@ -632,12 +809,35 @@ void boot_firmware(){
 
 	// Finish UART operations
 	while(UARTBusy(UART0_BASE)){}
+	// The receive ring lives in SRAM that the firmware is about to overwrite
+	uart_rx_disable(UART0);
+
+#ifdef BOOTLOADER_PROFILE
+	// The release message does not end in a newline
+	nl(UART0);
+	profile_dump_start(UART0);
+	start = profile_start();
+#endif
+
+	// The firmware can be copied over the cached keys, wipe them while aes still has its own copy
+	keys_wipe();
 
 	// VERY DANGEROUS
 	// Do not use globals after this function is called
-	copy_fw_to_ram((uint32_t *) addr, \
+	uint32_t aes_cycles = copy_fw_to_ram((uint32_t *) addr, \
 			(uint32_t *) 0x20000000, decrypted_metadata.metadata.fw_length, &aes);
-	bass_crypt((uint8_t *) 0x20000000, decrypted_metadata.metadata.fw_length);
+#ifdef BOOTLOADER_PROFILE
+	// The table is overwritten by the firmware now, the last two regions come from the stack
+	profile_dump_sample(UART0, PROFILE_COPY_FW_TO_RAM, aes_cycles);
+	profile_dump_sample(UART0, PROFILE_BASS_CRYPT, profile_start() - start - aes_cycles);
+	nl(UART0);
+	while(UARTBusy(UART0_BASE)){}
+#else
+	(void) aes_cycles;
+#endif
+
+	// Firmware expects the clock it would get out of reset
+	SysCtlClockSet(FW_CLOCK_CONFIG);
 	
 	jump_to_fw(0x20000001, 0x20007FF0);
 
@@ -647,6 +847,10 @@ void boot_firmware(){
 
 void jump_to_fw(uint32_t sram_start, uint32_t sram_end) {
 
+#ifdef BOOTLOADER_HOST
+	// The firmware can't run on the host, the simulator saves it and resets
+	sim_jump_to_fw(sram_start, sram_end);
+#else
 	uint32_t fw_stack_pointer = sram_end;
 
 	// Get the application's reset vector address from the SRAM start address (after initial SP)
@@ -660,37 +864,74 @@ void jump_to_fw(uint32_t sram_start, uint32_t sram_end) {
 
     // Jump to the application's reset handler
     fw_entry();
+#endif
 }
 
 
-void copy_fw_to_ram(uint32_t *fw_ptr, uint32_t *sram_ptr, uint32_t fw_size, Aes *cipher) {
+// Flash side of copy_fw_to_ram, the Dumb Bass program reads the firmware through it
+typedef struct fw_decode {
+	Aes *cipher;
+	const uint8_t *fw_ptr;
+	uint32_t fw_remaining;
+	uint32_t aes_cycles;
+	uint8_t chunk[FW_DECODE_CHUNK];
+} fw_decode;
+
+// Decrypts the next chunk of firmware for the Dumb Bass program
+static bool fw_decode_refill(computer_state *state) {
+	fw_decode *decode = (fw_decode *) state->sys_read_context;
+	uint32_t len = decode->fw_remaining;
+	uint32_t start;
 
-	wc_AesCtrEncrypt(cipher, (uint8_t *) sram_ptr, (uint8_t *) fw_ptr, fw_size);
+	if (len == 0) {
+		return false;
+	}
+	if (len > FW_DECODE_CHUNK) {
+		len = FW_DECODE_CHUNK;
+	}
+
+	start = profile_start();
+	if (wc_AesCtrEncrypt(decode->cipher, decode->chunk, decode->fw_ptr, len)) {
+		uart_write_str(UART0, "FATAL aes decrypt error\n");
+		while(UARTBusy(UART0_BASE)){}
+		SysCtlReset();
+	}
+	decode->aes_cycles += profile_start() - start;
+
+	decode->fw_ptr += len;
+	decode->fw_remaining -= len;
+	state->sys_read_buffer = decode->chunk;
+	state->sys_read_remaining = len;
+	return true;
+}
+
+// Decrypts the firmware and runs the Dumb Bass program over it a chunk at a time, so SRAM is only written once
+// and nothing past the point where the program stops is decrypted. Returns the cycles spent in AES
+uint32_t copy_fw_to_ram(uint32_t *fw_ptr, uint32_t *sram_ptr, uint32_t fw_size, Aes *cipher) {
+	fw_decode decode = {cipher, (const uint8_t *) fw_ptr, fw_size, 0};
+
+	bass_crypt((uint8_t *) sram_ptr, fw_size, fw_decode_refill, &decode);
 
     // Clean up AES context
     wc_AesFree(cipher);
+	return decode.aes_cycles;
 }
 
 
 
-// verifies an hmac, given the data, key and hash to test against, returns boolean True if verification correct
-bool verify_hmac(uint8_t * data, uint32_t data_len, uint8_t * key, uint8_t * test_hash){
-    Hmac hmac;
+// verifies an hmac with the cached key, given the data and hash to test against, returns boolean True if verification correct
+bool verify_hmac(uint8_t * data, uint32_t data_len, uint8_t * test_hash){
+    wc_Sha256 hmac;
+	uint32_t start = profile_start();
 
-    if (wc_HmacSetKey(&hmac, WC_SHA256, key, SECRETS_HMAC_KEY_LEN) != 0) {
-        uart_write_str(UART0, "Couldn't init HMAC");
-		while(UARTBusy(UART0_BASE)){}
-        SysCtlReset();
-}
-
-    if( wc_HmacUpdate(&hmac, data, data_len) != 0) {
+    if (keys_hmac(&hmac) != 0 || wc_Sha256Update(&hmac, data, data_len) != 0) {
     uart_write_str(UART0, "Couldn't init HMAC");
 	while(UARTBusy(UART0_BASE)){}
     SysCtlReset();
 }
 
     uint8_t hash[SECRETS_HASH_LENGTH]; // 256/8 = 32
-    if (wc_HmacFinal(&hmac, hash) != 0) {
+    if (keys_hmac_final(&hmac, hash) != 0) {
         uart_write_str(UART0, "Couldn't compute hash");
 		while(UARTBusy(UART0_BASE)){}
         SysCtlReset();
@@ -701,10 +942,35 @@ bool verify_hmac(uint8_t * data, uint32_t data_len, uint8_t * key, uint8_t * tes
 			ret = false;
 		}
 	}
+	profile_end(PROFILE_VERIFY_HMAC, start);
 	return ret;
 }
 
 
+// HMAC over a stored package (IV, metadata, message and firmware), its signature and the vault version
+// Matching the tag in the vault means the partition has not changed since its signature was last checked
+void compute_boot_tag(uint8_t * tag, uint8_t * package, uint32_t package_len, uint8_t * signature, uint32_t version){
+    wc_Sha256 hmac;
+	uint32_t start = profile_start();
+
+    if (keys_hmac(&hmac) != 0 ||
+		wc_Sha256Update(&hmac, package, package_len) != 0 ||
+		wc_Sha256Update(&hmac, signature, SECRETS_SIGNATURE_LENGTH) != 0 ||
+		wc_Sha256Update(&hmac, (uint8_t *) &version, sizeof(version)) != 0) {
+        uart_write_str(UART0, "Couldn't compute hash");
+		while(UARTBusy(UART0_BASE)){}
+        SysCtlReset();
+	}
+
+    if (keys_hmac_final(&hmac, tag) != 0) {
+        uart_write_str(UART0, "Couldn't compute hash");
+		while(UARTBusy(UART0_BASE)){}
+        SysCtlReset();
+	}
+	profile_end(PROFILE_BOOT_TAG, start);
+}
+
+
 unsigned int my_rng_seed_gen(void) {
 	uart_write_str(UART0, "RNG IS BEING USED OH NO THIS IS BAD\n");
 	SysCtlReset();
@@ -1,5 +1,7 @@
 #include "bootloader.h"
 #include "butils.h"
+#include "crc16.h"
+#include "profile.h"
 #include "computer.h"
 #include "bass.h"
 #include "uart/uart.h"
@@ -17,6 +19,7 @@
 
 #include "driverlib/rom.h"
 #include "driverlib/rom_map.h"
+
 /*
  * Program a stream of bytes to the flash.
  * This function takes the starting address of a 1KB page, a pointer to the
@@ -25,28 +28,68 @@
  * This functions performs an erase of the specified flash page before writing
  * the data.
  */
+static long program_flash_words(void* page_addr, unsigned char * data, unsigned int data_len, frame_rx *rx);
+
 long program_flash(void* page_addr, unsigned char * data, unsigned int data_len) {
+    uint32_t start = profile_start();
+    long ret;
+
+    // Erase next FLASH page
+    FlashErase((uint32_t) page_addr);
+
+    ret = program_flash_words(page_addr, data, data_len, NULL);
+    profile_end(PROFILE_PROGRAM_FLASH, start);
+    return ret;
+}
+
+/*
+ * Program a stream of bytes into a flash page that has already been erased.
+ *
+ * If rx is not NULL the data is programmed FLASH_POLL_WORDS words at a time and
+ * the frame receiver is polled in between, so the next frame keeps coming in
+ * from the UART between the words of this one (see FLASH_POLL_WORDS).
+ */
+long program_flash_erased(void* page_addr, unsigned char * data, unsigned int data_len, frame_rx *rx) {
+    uint32_t start = profile_start();
+    long ret;
+
+    ret = program_flash_words(page_addr, data, data_len, rx);
+    profile_end(PROFILE_PROGRAM_FLASH, start);
+    return ret;
+}
+
+static long program_flash_words(void* page_addr, unsigned char * data, unsigned int data_len, frame_rx *rx) {
     uint32_t word = 0;
+    uint32_t chunk;
+    uint32_t offset = 0;
     int ret;
     int i;
 
-    // Erase next FLASH page
-    FlashErase((uint32_t) page_addr);
+    // Get number of unused bytes in the last word
+    int rem = data_len % FLASH_WRITESIZE;
+    int num_full_bytes = data_len - rem;
 
-    // Clear potentially unused bytes in last word
-    // If data not a multiple of 4 (word size), program up to the last word
-    // Then create temporary variable to create a full last word
-    if (data_len % FLASH_WRITESIZE) {
-        // Get number of unused bytes
-        int rem = data_len % FLASH_WRITESIZE;
-        int num_full_bytes = data_len - rem;
-
-        // Program up to the last word
-        ret = FlashProgram((unsigned long *)data, (uint32_t) page_addr, num_full_bytes);
+    // Program all full words
+    while (offset < num_full_bytes) {
+        chunk = num_full_bytes - offset;
+        if (rx != NULL && chunk > FLASH_POLL_WORDS * FLASH_WRITESIZE) {
+            chunk = FLASH_POLL_WORDS * FLASH_WRITESIZE;
+        }
+
+        ret = FlashProgram((uint32_t *)(data + offset), (uint32_t) page_addr + offset, chunk);
         if (ret != 0) {
             return ret;
         }
+        offset += chunk;
 
+        if (rx != NULL) {
+            frame_rx_poll(rx);
+        }
+    }
+
+    // Clear potentially unused bytes in last word
+    // If data not a multiple of 4 (word size), create temporary variable to create a full last word
+    if (rem) {
         // Create last word variable -- fill unused with 0xFF
         for (i = 0; i < rem; i++) {
             word = (word >> 8) | (data[num_full_bytes + i] << 24); // Essentially a shift register from MSB->LSB
@@ -57,29 +100,33 @@ long program_flash(void* page_addr, unsigned char * data, unsigned int data_len)
 
         // Program word
         return FlashProgram(&word, (uint32_t) page_addr + num_full_bytes, 4);
-    } else {
-        // Write full buffer of 4-byte words
-        return FlashProgram((unsigned long *)data, (uint32_t) page_addr, data_len);
     }
+    return 0;
+}
+
+// Erases a run of flash blocks, returns nonzero if any erase failed
+long erase_flash_blocks(uint32_t first_block, uint32_t blocks) {
+	for (uint32_t i = 0; i < blocks; i++) {
+		if (FlashErase((first_block + i) << 10)) {
+			return 1;
+		}
+	}
+	return 0;
 }
 
 //read a little endian short from serial
 uint16_t read_short(void) {
-	int read = 0;
-	uint16_t r = 0;
-	uint8_t c;
-	c = uart_read(UART0, BLOCKING, &read);
-	r = c;
-	c = uart_read(UART0, BLOCKING, &read);
-	r |= (c << 8);
-	return r;
+	uint8_t c[2];
+	uart_read_block(UART0, c, 2, UART_WAIT_FOREVER);
+	return c[0] | (c[1] << 8);
 }
 
 // Reads in at most READ_BUFFER_SIZE bytes into buffer 
 // This function does not perform error checking if block size is zero
 uint32_t read_frame(uint8_t * buffer) {
 	
-	
+	uint32_t start = profile_start();
+	uint32_t size;
 	int read = 0;
 	
 	//wait for a frame instruction
@@ -88,6 +135,14 @@ uint32_t read_frame(uint8_t * buffer) {
 		instruction = uart_read(UART0, BLOCKING, &read);
 	}
 
+	size = read_frame_body(buffer);
+	profile_end(PROFILE_READ_FRAME, start);
+	return size;
+}
+
+// Same as read_frame but for when the frame instruction has already been consumed
+uint32_t read_frame_body(uint8_t * buffer) {
+
 	uint16_t data_size;
 	data_size = read_short();
 	if (data_size == 0) {
@@ -97,9 +152,7 @@ uint32_t read_frame(uint8_t * buffer) {
 		uart_write_str(UART0, "Frame size too big!\n");
 		SysCtlReset();
 	}
-	for (int i = 0; i < data_size; i++) {
-		buffer[i] = uart_read(UART0, BLOCKING, &read);
-	}
+	uart_read_block(UART0, buffer, data_size, UART_WAIT_FOREVER);
 
     uint16_t checksum = read_short();
 
@@ -111,7 +164,7 @@ uint32_t read_frame(uint8_t * buffer) {
 		}
 
 		uart_write_str(UART0, "CHECKSUM CHECKED ;)");
-	// Do not write acknowledge in this function, instead it is up to the caller to run logic and acknowledge the frame \
+	// Do not write acknowledge in this function, instead it is up to the caller to run logic and acknowledge the frame
 	// Only write a restart here if frame is corrupted
 	
 	//uart_write_str(UART0, "A");
@@ -121,10 +174,153 @@ uint32_t read_frame(uint8_t * buffer) {
 	//uart_write_str(UART0, "R");
 }
 
+// Prepares rx to receive the next frame into buffer, bytes are only consumed by frame_rx_poll
+void frame_rx_start(frame_rx *rx, uint8_t *buffer) {
+	rx->buffer = buffer;
+	rx->state = FRAME_RX_WAIT;
+	rx->received = 0;
+	rx->size = 0;
+	rx->checksum = 0;
+}
+
+// Consumes whatever bytes are waiting in the UART without blocking
+// Returns true once the whole frame has been received and its checksum checked out
+// Unlike read_frame this prints nothing on success, the updater may be streaming the next frame already
+bool frame_rx_poll(frame_rx *rx) {
+	int read = 0;
+	uint8_t c;
+
+	while (rx->state != FRAME_RX_DONE) {
+		// Frame data is received by uDMA straight into the buffer, the CPU only checks it finished
+		if (rx->state == FRAME_RX_DATA) {
+			if (!uart_rx_dma_done(UART0)) {
+				return false;
+			}
+			rx->received = rx->size;
+			rx->state = FRAME_RX_CRC_LO;
+			continue;
+		}
+
+		c = uart_read(UART0, NONBLOCKING, &read);
+		if (!read) {
+			return false;
+		}
+
+		switch (rx->state) {
+			case FRAME_RX_WAIT:
+				if (c == FRAME) {
+					rx->state = FRAME_RX_SIZE_LO;
+				}
+				break;
+			case FRAME_RX_SIZE_LO:
+				rx->size = c;
+				rx->state = FRAME_RX_SIZE_HI;
+				break;
+			case FRAME_RX_SIZE_HI:
+				rx->size |= (c << 8);
+				// zero length frames have no data or checksum, same as read_frame
+				if (rx->size == 0) {
+					rx->state = FRAME_RX_DONE;
+				} else if (rx->size > READ_BUFFER_SIZE) {
+					uart_write_str(UART0, "Frame size too big!\n");
+					SysCtlReset();
+				} else {
+					uart_rx_dma_start(UART0, rx->buffer, rx->size);
+					rx->state = FRAME_RX_DATA;
+				}
+				break;
+			case FRAME_RX_CRC_LO:
+				rx->checksum = c;
+				rx->state = FRAME_RX_CRC_HI;
+				break;
+			case FRAME_RX_CRC_HI:
+				rx->checksum |= (c << 8);
+				if (verify_checksum(rx->checksum, rx->buffer, rx->size)) {
+					uart_write_str(UART0, "Checksum did not checkout");
+					SysCtlReset();
+				}
+				rx->state = FRAME_RX_DONE;
+				break;
+			default:
+				break;
+		}
+	}
+	return true;
+}
+
+// Blocks until the frame in rx has been fully received, returns its data size
+uint32_t frame_rx_finish(frame_rx *rx) {
+	while (!frame_rx_poll(rx)) {
+	}
+	return rx->size;
+}
+
+// Reads the probe frame sent after a baud change, returns true if it arrived intact
+static bool read_baud_probe(void) {
+	uint8_t c = 0;
+	uint8_t probe[BAUD_PROBE_LEN + 2];
+
+	// Skip anything garbled by the switch until the frame instruction
+	while (c != FRAME) {
+		if (!uart_read_block(UART0, &c, 1, BAUD_PROBE_TIMEOUT)) {
+			return false;
+		}
+	}
+	if (uart_read_block(UART0, probe, 2, BAUD_PROBE_TIMEOUT) != 2 || (probe[0] | (probe[1] << 8)) != BAUD_PROBE_LEN) {
+		return false;
+	}
+	if (uart_read_block(UART0, probe, BAUD_PROBE_LEN + 2, BAUD_PROBE_TIMEOUT) != BAUD_PROBE_LEN + 2) {
+		return false;
+	}
+	if (verify_checksum(probe[BAUD_PROBE_LEN] | (probe[BAUD_PROBE_LEN + 1] << 8), probe, BAUD_PROBE_LEN)) {
+		return false;
+	}
+	for (int i = 0; i < BAUD_PROBE_LEN; i++) {
+		if (probe[i] != i) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Answers a baud rate proposal from the updater and switches to it, returns true if the new rate is in use
+// The probe frame and the updater's answer to our ACK both have to arrive at the new rate,
+// otherwise both sides go back to UART_DEFAULT_BAUD after their timeouts. Once the updater's
+// answer arrives we confirm with BAUD, the updater stays at the new rate only if it gets it
+bool negotiate_baud(uint32_t baud) {
+	uint8_t c = 0;
+
+	if (baud < UART_DEFAULT_BAUD || baud > BAUD_MAX) {
+		baud = UART_DEFAULT_BAUD;
+	}
+
+	uart_write(UART0, BAUD);
+	for (int i = 0; i < 4; i++) {
+		uart_write(UART0, (baud >> (8 * i)) & 0xFF);
+	}
+	if (baud == UART_DEFAULT_BAUD) {
+		return false;
+	}
+
+	uart_set_baud(UART0, baud);
+	if (read_baud_probe()) {
+		uart_write(UART0, ACK);
+		if (uart_read_block(UART0, &c, 1, BAUD_PROBE_TIMEOUT) == 1 && c == ACK) {
+			uart_write(UART0, BAUD);
+			return true;
+		}
+	}
+
+	uart_set_baud(UART0, UART_DEFAULT_BAUD);
+	return false;
+}
+
 // Takes in proposed checksum and data returns bool of verification
 bool verify_checksum(uint16_t given_checksum, uint8_t *data, uint32_t length) {
 
-	uint16_t checksum = ROM_Crc16(0, data, length); 
+	uint32_t start = profile_start();
+	uint16_t checksum = crc16(0, data, length);
+	profile_end(PROFILE_VERIFY_CHECKSUM, start);
 
 	if (checksum == given_checksum) {
 
@@ -158,17 +354,23 @@ void uart_write_hex_bytes(uint8_t uart, uint8_t * start, uint32_t len) {
     }
 }
 
-void bass_crypt(uint8_t *buf, uint32_t buf_len) {
+// Runs the Dumb Bass program into out, buf_len bytes
+// The program's input comes from refill one chunk at a time, context is handed to it in the state
+void bass_crypt(uint8_t *out, uint32_t buf_len, computer_refill refill, void *context) {
 
 	nl(UART0);
 	uart_write_str(UART0, "Running Dumb Bass program\n");
 	computer_state state = {0};
 	state.instructions = (computer_instruction *) instructions;
-	state.sys_write_buffer = buf;
-	state.sys_read_buffer = buf;
-	state.sys_read_remaining = buf_len;
+	state.sys_write_buffer = out;
 	state.sys_write_remaining = buf_len;
+	state.sys_read_refill = refill;
+	state.sys_read_context = context;
+#ifdef BASS_NATIVE
+	bass_native(&state);
+#else
 	computer_interpret_program(&state);
+#endif
 
 	uart_write_str(UART0, "Finishing Dumb Bass program\n");
 	return;
@@ -15,118 +15,404 @@
 
 #include "computer.h"
 #include <stdbool.h>
+#include <string.h>
 /*
  * 8-bit Harvard architecture, 6 general purpose registers, 
  *
+ * The program is decoded once before it runs: every slot gets a pointer to its
+ * handler and register masks become indices into the register file, so running
+ * an instruction is one indirect call with no opcode or register switches.
+ * Bad opcodes and registers are decoded to handlers that reset when reached,
+ * like the old interpreter did.
+ *
+ * Loops that only XOR the buffer with a repeating key (bananaaa.dumbbass) are
+ * recognized after decoding. Their first slot runs every pass but the last with
+ * word XORs and leaves the VM as if it had interpreted them, the interpreter
+ * does the last pass and whatever comes after.
  */
 
 
+// True once there is input to read, asks sys_read_refill for the next chunk when the current one is used up
+bool computer_read_more(computer_state *state) {
+	if (state->sys_read_remaining == 0 && state->sys_read_refill) {
+		return state->sys_read_refill(state);
+	}
+	return state->sys_read_remaining != 0;
+}
+
+// Reads up to count bytes into memory at a, a block can straddle two chunks of input
+static uint32_t computer_read_block(computer_state *state, uint8_t a, uint32_t count) {
+	uint32_t read = 0;
+	uint32_t len;
+
+	while (read < count && computer_read_more(state)) {
+		len = count - read;
+		if (len > state->sys_read_remaining) {
+			len = state->sys_read_remaining;
+		}
+		for (uint32_t i = 0; i < len; i++) {
+			state->memory[(uint8_t) (a + read + i)] = state->sys_read_buffer[i];
+		}
+		state->sys_read_buffer += len;
+		state->sys_read_remaining -= len;
+		read += len;
+	}
+	return read;
+}
+
 uint8_t computer_interpret_program(computer_state* state) {
-	computer_instruction ins;
-	bool end = false;
-	bool increment_ip; 
-	while (!end) {
-		increment_ip = true;
-		ins = state->instructions[state->ip];
-		//uart_write_hex(UART0, ins.opcode << 16 | ins.a << 8 | ins.b);
+	computer_decoded_instruction program[COMP_PROGRAM_SLOTS];
+	const computer_decoded_instruction *ins;
+
+	computer_decode_program(state->instructions, program);
+	computer_match_xor_loop(state, program);
+	do {
+		ins = &program[state->ip];
+		//uart_write_hex(UART0, state->ip);
+	} while (!ins->op(state, ins->a, ins->b));
+	return state->r[COMP_RA];
+}
+
+// instructions must hold COMP_PROGRAM_SLOTS slots, bass.c is padded to MAX_BASS_SIZE
+void computer_decode_program(const computer_instruction *instructions, computer_decoded_instruction *program) {
+	for (uint32_t i = 0; i < COMP_PROGRAM_SLOTS; i++) {
+		computer_instruction ins = instructions[i];
+		computer_decoded_instruction *out = &program[i];
+		bool reg_a = true;
+		bool reg_b = true;
 
 		switch (ins.opcode) {
 			case COMP_MOV_CODE:
-				computer_mov(state, ins.a, ins.b);
-				//uart_write_str(UART0, "MOV\n");
+				out->op = computer_mov;
 				break;
 			case COMP_ADD_CODE:
-				computer_add(state, ins.a, ins.b);
+				out->op = computer_add;
 				break;
 			case COMP_SUB_CODE:
-				computer_sub(state, ins.a, ins.b);
+				out->op = computer_sub;
 				break;
 			case COMP_IMM_CODE:
-				//uart_write_str(UART0, "IMM\n");
-				computer_imm(state, ins.a, ins.b);
+				out->op = computer_imm;
+				reg_b = false;
 				break;
 			case COMP_CMP_CODE:
-				computer_cmp(state, ins.a, ins.b);
+				out->op = computer_cmp;
 				break;
 			case COMP_STM_CODE:
-				computer_stm(state, ins.a, ins.b);
+				out->op = computer_stm;
 				break;
 			case COMP_LDM_CODE:
-				computer_ldm(state, ins.a, ins.b);
+				out->op = computer_ldm;
 				break;
 			case COMP_SYS_CODE:
-				end = computer_sys(state, ins.a, ins.b);
+				out->op = computer_sys;
+				reg_a = false;
+				reg_b = false;
 				break;
 
 			case COMP_JMP_CODE:
-				//uart_write_str(UART0, "JMP\n");
-				computer_jmp(state, ins.a, ins.b);
-				increment_ip = false;
+				out->op = computer_jmp;
+				reg_a = false;
+				reg_b = false;
 				break;
 			case COMP_JNE_CODE:
-				computer_jne(state, ins.a, ins.b);
-				increment_ip = false;
+				out->op = computer_jne;
+				reg_a = false;
+				reg_b = false;
 				break;
 			case COMP_JLT_CODE:
-				computer_add(state, ins.a, ins.b);
-				increment_ip = false;
+				out->op = computer_jlt;
 				break;
 
 			case COMP_AND_CODE:
-				computer_and(state, ins.a, ins.b);
+				out->op = computer_and;
 				break;
 			case COMP_NOT_CODE:
-				computer_not(state, ins.a, ins.b);
+				out->op = computer_not;
 				break;
 			case COMP_ORR_CODE:
-				computer_orr(state, ins.a, ins.b);
+				out->op = computer_orr;
 				break;
 			case COMP_XOR_CODE:
-				computer_xor(state, ins.a, ins.b);
+				out->op = computer_xor;
 				break;
 			default:
-				computer_badins();
+				out->op = computer_badins;
+				reg_a = false;
+				reg_b = false;
+		}
+
+		out->a = reg_a ? computer_reg_index(ins.a) : ins.a;
+		out->b = reg_b ? computer_reg_index(ins.b) : ins.b;
+		if ((reg_a && out->a == COMP_BAD_REG) || (reg_b && out->b == COMP_BAD_REG)) {
+			out->op = computer_badreg;
+		}
+	}
+}
+
+// Looks for a JMP back to a loop shaped like one of the two below and hooks
+// its first slot, the first one found wins
+void computer_match_xor_loop(computer_state* state, computer_decoded_instruction *program) {
+	computer_xor_loop *loop = &state->xor_loop;
+	const computer_decoded_instruction *p;
+
+	loop->kind = COMP_LOOP_NONE;
+	for (uint32_t j = 0; j < COMP_PROGRAM_SLOTS; j++) {
+		uint32_t l = program[j].a;
+		if (program[j].op != computer_jmp || l > j) {
+			continue;
+		}
+		p = &program[l];
+
+		/*
+		 * imm rb count
+		 * imm ra sbr
+		 * sys addr _
+		 * mov rb ra
+		 * imm ra sbx
+		 * sys addr key
+		 * imm ra sbw
+		 * sys addr _
+		 * jmp <loop>
+		 */
+		if (j - l == 8 &&
+			p[0].op == computer_imm && p[0].a == COMP_RB && p[0].b != 0 &&
+			p[1].op == computer_imm && p[1].a == COMP_RA && p[1].b == COMP_SYS_READ_BLOCK &&
+			p[2].op == computer_sys &&
+			p[3].op == computer_mov && p[3].a == COMP_RB && p[3].b == COMP_RA &&
+			p[4].op == computer_imm && p[4].a == COMP_RA && p[4].b == COMP_SYS_XOR_BLOCK &&
+			p[5].op == computer_sys && p[5].a == p[2].a &&
+			p[6].op == computer_imm && p[6].a == COMP_RA && p[6].b == COMP_SYS_WRITE_BLOCK &&
+			p[7].op == computer_sys && p[7].a == p[2].a &&
+			// the key must not be overwritten by the data
+			(uint8_t) (p[5].b - p[2].a) >= p[0].b && (uint8_t) (p[2].a - p[5].b) >= p[0].b) {
+			loop->kind = COMP_LOOP_BLOCK;
+			loop->count = p[0].b;
+			loop->addr = p[2].a;
+			loop->key = p[5].b;
+		}
+
+		/*
+		 * imm ra sr
+		 * sys _ _
+		 * ldm rb index
+		 * xor rb ra
+		 * imm ra sw
+		 * sys _ _
+		 * imm step 1
+		 * imm mask_reg mask		; mask + 1 is a power of two
+		 * add index step
+		 * and index mask_reg
+		 * jmp <loop>
+		 */
+		if (j - l == 10 &&
+			p[0].op == computer_imm && p[0].a == COMP_RA && p[0].b == COMP_SYS_READ &&
+			p[1].op == computer_sys &&
+			p[2].op == computer_ldm && p[2].a == COMP_RB &&
+			p[3].op == computer_xor && p[3].a == COMP_RB && p[3].b == COMP_RA &&
+			p[4].op == computer_imm && p[4].a == COMP_RA && p[4].b == COMP_SYS_WRITE &&
+			p[5].op == computer_sys &&
+			p[6].op == computer_imm && p[6].b == 1 &&
+			p[7].op == computer_imm && (p[7].b & (p[7].b + 1)) == 0 &&
+			p[8].op == computer_add && p[8].a == p[2].b && p[8].b == p[6].a &&
+			p[9].op == computer_and && p[9].a == p[2].b && p[9].b == p[7].a &&
+			p[6].a != p[7].a &&
+			p[2].b != COMP_RA && p[2].b != COMP_RB && p[2].b != p[6].a && p[2].b != p[7].a) {
+			loop->kind = COMP_LOOP_BYTE;
+			loop->index = p[2].b;
+			loop->step = p[6].a;
+			loop->mask_reg = p[7].a;
+			loop->mask = p[7].b;
+		}
+
+		if (loop->kind != COMP_LOOP_NONE) {
+			loop->op = program[l].op;
+			program[l].op = computer_run_xor_loop;
+			return;
+		}
+	}
+}
+
+// Runs the passes of the matched loop that don't end the program, then the slot it replaced
+bool computer_run_xor_loop(computer_state* state, uint8_t a, uint8_t b) {
+	computer_xor_loop *loop = &state->xor_loop;
+	uint8_t key[256];
+	uint32_t len = state->sys_read_remaining;
+	uint32_t period;
+	uint32_t phase = 0;
+	uint32_t done;
+
+	if (len > state->sys_write_remaining) {
+		len = state->sys_write_remaining;
+	}
+	// The pass that runs out of data, or of the current chunk, is left to the interpreter,
+	// and so is a read and write buffer that overlap without being the same
+	if (len == 0 || (state->sys_read_buffer != state->sys_write_buffer &&
+			state->sys_read_buffer < state->sys_write_buffer + len &&
+			state->sys_write_buffer < state->sys_read_buffer + len)) {
+		return loop->op(state, a, b);
+	}
+
+	if (loop->kind == COMP_LOOP_BLOCK) {
+		period = loop->count;
+		done = (len - 1) / period * period;
+		for (uint32_t i = 0; i < period; i++) {
+			key[i] = state->memory[(uint8_t) (loop->key + i)];
+		}
+	} else {
+		// The first pass indexes memory with the index as is
+		if (state->r[loop->index] > loop->mask) {
+			return loop->op(state, a, b);
+		}
+		period = loop->mask + 1;
+		phase = state->r[loop->index];
+		done = len - 1;
+		memcpy(key, state->memory, period);
+	}
+	if (done == 0) {
+		return loop->op(state, a, b);
+	}
+
+	// Input from another buffer is XORed at its destination
+	if (state->sys_read_buffer != state->sys_write_buffer) {
+		memcpy(state->sys_write_buffer, state->sys_read_buffer, done);
+	}
+	computer_xor_stream(state->sys_write_buffer, done, key, period, phase);
+	state->sys_read_buffer += done;
+	state->sys_write_buffer += done;
+	state->sys_read_remaining -= done;
+	state->sys_write_remaining -= done;
+
+	// Registers and memory as the last pass leaves them
+	if (loop->kind == COMP_LOOP_BLOCK) {
+		const uint8_t *last = state->sys_write_buffer - period;
+		for (uint32_t i = 0; i < period; i++) {
+			state->memory[(uint8_t) (loop->addr + i)] = last[i];
+		}
+		state->r[COMP_RA] = period;
+		state->r[COMP_RB] = period;
+	} else {
+		state->r[COMP_RA] = COMP_SYS_WRITE;
+		state->r[COMP_RB] = state->sys_write_buffer[-1];
+		state->r[loop->step] = 1;
+		state->r[loop->mask_reg] = loop->mask;
+		state->r[loop->index] = (phase + done) & loop->mask;
+	}
+
+	return loop->op(state, a, b);
+}
 
+// buf[i] ^= key[(phase + i) % period], a word at a time when the key is a whole number of words
+// Words go through memcpy, which the compiler turns into single loads and stores on the aligned buffer
+void computer_xor_stream(uint8_t *buf, uint32_t len, const uint8_t *key, uint32_t period, uint32_t phase) {
+	uint32_t words[64];
+	uint8_t rotated[256];
+	uint32_t word;
+
+	while (len && ((uint32_t) buf & 3)) {
+		*buf++ ^= key[phase];
+		phase = (phase + 1) % period;
+		len--;
+	}
+
+	if (period % 4 == 0 && len >= period) {
+		uint32_t n = period / 4;
+
+		// The key as it lines up with the words from here on
+		for (uint32_t i = 0; i < period; i++) {
+			rotated[i] = key[(phase + i) % period];
+		}
+		memcpy(words, rotated, period);
+		while (len >= period) {
+			for (uint32_t i = 0; i < n; i++) {
+				memcpy(&word, buf + 4 * i, sizeof(word));
+				word ^= words[i];
+				memcpy(buf + 4 * i, &word, sizeof(word));
+			}
+			buf += period;
+			len -= period;
 		}
-		if (increment_ip) {
-			state->ip += 1;
+	}
+
+	while (len--) {
+		*buf++ ^= key[phase];
+		if (++phase == period) {
+			phase = 0;
 		}
 	}
-	return state->ra;
 }
 
-void computer_badins(void) {
+uint8_t computer_reg_index(uint8_t reg_mask) {
+	switch (reg_mask) {
+		case COMP_RA_MASK:
+			return COMP_RA;
+		case COMP_RB_MASK:
+			return COMP_RB;
+		case COMP_RC_MASK:
+			return COMP_RC;
+		case COMP_RD_MASK:
+			return COMP_RD;
+		case COMP_RE_MASK:
+			return COMP_RE;
+		case COMP_RF_MASK:
+			return COMP_RF;
+		default:
+			return COMP_BAD_REG;
+	}
+}
+
+bool computer_badins(computer_state* state, uint8_t a, uint8_t b) {
 	uart_write_str(UART0, "Bad/unimplemented instruction\n");
 	while(UARTBusy(UART0_BASE)){}
 	SysCtlReset();
+	return true;
+}
+
+bool computer_badreg(computer_state* state, uint8_t a, uint8_t b) {
+	uart_write_str(UART0, "Invalid register number\n");
+	while(UARTBusy(UART0_BASE)){}
+	SysCtlReset();
+	return true;
 }
 
-void computer_mov(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, (computer_read_reg(state, b)));
+bool computer_mov(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] = state->r[b];
+	state->ip++;
+	return false;
 }
 
 // Ra <- Ra + Rb
-void computer_add(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, (computer_read_reg(state, a) + computer_read_reg(state, b)));
+bool computer_add(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] += state->r[b];
+	state->ip++;
+	return false;
 }
 
 // Ra <- Ra - Rb
-void computer_sub(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, (computer_read_reg(state, a) - computer_read_reg(state, b)));
+bool computer_sub(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] -= state->r[b];
+	state->ip++;
+	return false;
 }
 
 // Ra <- b
-void computer_imm(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, b);
+bool computer_imm(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] = b;
+	state->ip++;
+	return false;
 }
 
 //TODO: idk if this works lol
-void computer_cmp(computer_state* state, uint8_t a, uint8_t b) {
-	uint8_t ra = computer_read_reg(state, a);
-	uint8_t rb = computer_read_reg(state, b);
+bool computer_cmp(computer_state* state, uint8_t a, uint8_t b) {
+	state->fl = computer_cmp_flags(state->r[a], state->r[b]);
+	state->ip++;
+	return false;
+}
 
+// Flags for CMP ra rb, shared with the code tools/basspiler.py generates
+uint8_t computer_cmp_flags(uint8_t ra, uint8_t rb) {
 	// negate rb
-	uint8_t rbn = ((!computer_read_reg(state, b)) + 1);
+	uint8_t rbn = ((!rb) + 1);
 
 	uint8_t signa = ((ra >> 7) & 1);
 	uint8_t signb = ((rb >> 7) & 1);
@@ -137,7 +423,7 @@ void computer_cmp(computer_state* state, uint8_t a, uint8_t b) {
 	uint8_t zero = result == 0;
 	uint8_t overflow = (!(signa ^ signb)) & (signr ^ signa);
 
-	state->fl = signr << COMP_FLAG_SIGN_SHIFT | \
+	return signr << COMP_FLAG_SIGN_SHIFT | \
 				carry << COMP_FLAG_CARRY_SHIFT | \
 				zero << COMP_FLAG_ZERO_SHIFT | \
 				overflow << COMP_FLAG_OVERFLOW_SHIFT;
@@ -145,50 +431,94 @@ void computer_cmp(computer_state* state, uint8_t a, uint8_t b) {
 
 
 // *Ra = Rb
-void computer_stm(computer_state* state, uint8_t a, uint8_t b) {
-	state->memory[computer_read_reg(state, a)] = computer_read_reg(state, b);
+bool computer_stm(computer_state* state, uint8_t a, uint8_t b) {
+	state->memory[state->r[a]] = state->r[b];
+	state->ip++;
+	return false;
 }
 
 // Ra = *Rb
-void computer_ldm(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, state->memory[computer_read_reg(state, b)]);
+bool computer_ldm(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] = state->memory[state->r[b]];
+	state->ip++;
+	return false;
 }
 
 //TODO: fixme
-// a and b are not used, just set them to garbage values
+// a and b are only used by the block syscalls, otherwise just set them to garbage values
 // Ra: syscall
+// Block syscalls move Rb bytes (less at the end of the buffers) and leave the count in Ra,
+// memory addresses wrap around at 256
 bool computer_sys(computer_state* state, uint8_t a, uint8_t b) {
-	uint8_t syscode = state->ra;
-	//uart_write_hex(UART0, state->ra);
+	uint8_t syscode = state->r[COMP_RA];
+	uint32_t count = state->r[COMP_RB];
+
+	// ip moves past the SYS even when it ends the program
+	state->ip++;
+	//uart_write_hex(UART0, state->r[COMP_RA]);
 
 	switch (syscode) {
 		// move rb into write buffer
 		case COMP_SYS_WRITE:
 			if (state->sys_write_remaining == 0) {
-				state->ra = 33;
+				state->r[COMP_RA] = 33;
 				return true;
 			}
-			*state->sys_write_buffer = state->rb;
+			*state->sys_write_buffer = state->r[COMP_RB];
 			state->sys_write_buffer++;
 			state->sys_write_remaining--;
 			break;
 
 		// read into ra
 		case COMP_SYS_READ:
-			if (state->sys_read_remaining == 0) {
-				state->ra = 44;
+			if (!computer_read_more(state)) {
+				state->r[COMP_RA] = 44;
 				return true;
 			}
-			state->ra = *state->sys_read_buffer;
+			state->r[COMP_RA] = *state->sys_read_buffer;
 			state->sys_read_buffer++;
 			state->sys_read_remaining--;
 			break;
 
+		// move rb bytes of memory at a into write buffer
+		case COMP_SYS_WRITE_BLOCK:
+			if (state->sys_write_remaining == 0) {
+				state->r[COMP_RA] = 33;
+				return true;
+			}
+			if (count > state->sys_write_remaining) {
+				count = state->sys_write_remaining;
+			}
+			for (uint32_t i = 0; i < count; i++) {
+				state->sys_write_buffer[i] = state->memory[(uint8_t) (a + i)];
+			}
+			state->sys_write_buffer += count;
+			state->sys_write_remaining -= count;
+			state->r[COMP_RA] = count;
+			break;
+
+		// read rb bytes into memory at a
+		case COMP_SYS_READ_BLOCK:
+			if (!computer_read_more(state)) {
+				state->r[COMP_RA] = 44;
+				return true;
+			}
+			state->r[COMP_RA] = computer_read_block(state, a, count);
+			break;
+
+		// xor rb bytes of memory at b into memory at a
+		case COMP_SYS_XOR_BLOCK:
+			for (uint32_t i = 0; i < count; i++) {
+				state->memory[(uint8_t) (a + i)] ^= state->memory[(uint8_t) (b + i)];
+			}
+			state->r[COMP_RA] = count;
+			break;
+
 		case COMP_SYS_EXIT:
 			return true;
 
 		default:
-			state->ra = 55;
+			state->r[COMP_RA] = 55;
 			return true;
 	}
 
@@ -196,106 +526,50 @@ bool computer_sys(computer_state* state, uint8_t a, uint8_t b) {
 }
 
 // b is unused, ip = a
-void computer_jmp(computer_state* state, uint8_t a, uint8_t b) {
+bool computer_jmp(computer_state* state, uint8_t a, uint8_t b) {
 	state->ip = a;
+	return false;
 }
 
 // b is unused, ip = a if zero is set
-void computer_jne(computer_state* state, uint8_t a, uint8_t b) {
+bool computer_jne(computer_state* state, uint8_t a, uint8_t b) {
 	state->ip+=1;
 	if ((state->fl >> COMP_FLAG_ZERO_SHIFT) & 1) {
 		state->ip = a;
 	}
-	
+	return false;
 }
 
-// sf <> of
-void computer_jls(computer_state* state, uint8_t a, uint8_t b) {
-	state->ip+=1;
-	if (((state->fl >> COMP_FLAG_SIGN_SHIFT) & 1) ^ \
-		((state->fl >> COMP_FLAG_OVERFLOW_SHIFT) & 1)) {
-		state->ip = a;
-	}
+// The interpreter has always run JLT as an ADD that does not move ip, which
+// loops forever. Kept as is so existing programs behave the same
+bool computer_jlt(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] += state->r[b];
+	return false;
 }
 
 // Ra <- Ra & Rb
-void computer_and(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, (computer_read_reg(state, a) & computer_read_reg(state, b)));
+bool computer_and(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] &= state->r[b];
+	state->ip++;
+	return false;
 }
 
 // Ra <- !Rb
-void computer_not(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, !computer_read_reg(state, b));
+bool computer_not(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] = !state->r[b];
+	state->ip++;
+	return false;
 }
 
 // Ra <- Ra | Rb
-void computer_orr(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, (computer_read_reg(state, a) | computer_read_reg(state, b)));
-}
-
-void computer_xor(computer_state* state, uint8_t a, uint8_t b) {
-	computer_write_reg(state, a, (computer_read_reg(state, a) ^ computer_read_reg(state, b)));
-}
-
-uint8_t computer_read_reg(computer_state* state, uint8_t reg_num) {
-	switch (reg_num) {
-		case COMP_RA_MASK:
-			return state->ra;
-			break;
-		case COMP_RB_MASK:
-			return state->rb;
-			break;
-		case COMP_RC_MASK:
-			return state->rc;
-			break;
-		case COMP_RD_MASK:
-			return state->rd;
-			break;
-		case COMP_RE_MASK:
-			return state->re;
-			break;
-		case COMP_RF_MASK:
-			return state->rf;
-			break;
-		default:
-			uart_write_str(UART0, "Invalid register number\n");
-			while(UARTBusy(UART0_BASE)){}
-			SysCtlReset();
-	}
-	return 0;
-
+bool computer_orr(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] |= state->r[b];
+	state->ip++;
+	return false;
 }
 
-void computer_write_reg(computer_state* state, uint8_t reg_num, uint8_t value) {
-	/*
-	uart_write_str(UART0, "Writing value");
-	uart_write_hex(UART0, value);
-	uart_write_str(UART0, "into ");
-	uart_write_hex(UART0, reg_num);
-	*/
-	switch (reg_num) {
-		case COMP_RA_MASK:
-			state->ra = value;
-			break;
-		case COMP_RB_MASK:
-			state->rb = value;
-			break;
-		case COMP_RC_MASK:
-			state->rc = value;
-			break;
-		case COMP_RD_MASK:
-			state->rd = value;
-			break;
-		case COMP_RE_MASK:
-			state->re = value;
-			break;
-		case COMP_RF_MASK:
-			state->rf = value;
-			break;
-		default:
-			uart_write_str(UART0, "Invalid register number\n");
-			while(UARTBusy(UART0_BASE)){}
-			SysCtlReset();
-	}
-	return;
+bool computer_xor(computer_state* state, uint8_t a, uint8_t b) {
+	state->r[a] ^= state->r[b];
+	state->ip++;
+	return false;
 }
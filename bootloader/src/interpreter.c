@@ -1,8 +1,12 @@
 #include <stdint.h>
 #include <bf.h>
+#include "profile.h"
 
-#define TAPE_SIZE 50
-#define STACK_SIZE 100
+/*
+ * bf_decrypt runs tools/bf_decrypt.bf over a key, compiled ahead of time into
+ * bf_program by tools/bfcompiler.py. The program keeps the pointer on the
+ * tape, so it is an index here.
+ */
 
 void load_tape(unsigned char *tape, uint8_t *encrypted_arr, uint8_t size) {
     for (uint8_t i = 0; i < size; i++) {
@@ -17,79 +21,78 @@ void save_tape(unsigned char *tape, uint8_t *encrypted_arr, uint8_t size) {
 }
 
 
-void bf_decrypt(uint8_t *encrypted_arr, uint8_t size) {
-
-    const char code[] = {'[', '>', ']', '>', '[', '-', '>', ']', '>', '>', '>', '>', '>', '>', '>', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '>', '+', '+', '+', '+', '+', '+', '+', '0', '[', '[', '>', ']', '<', '[', '>', '+', '<', '-', ']', '0', ']', '+', '+', '+', '+', '+', '+', '[', '[', '[', '>', ']', '<', '[', '>', '+', '<', '-', ']', '0', ']', '>', '[', '<', '+', '>', '-', ']', '+', '<', '-', ']', '0', '>', '>', '>', '>', '>', '>', '[', '-', '<', ']', '>', '>', '>', '>', '+', '+', '+', '+', '>', '+', '+', '+', '+', '>', '>', '>', '[', '<', '<', '+', '>', '>', '-', ']', '0', '>', '>', '>', '>', '>', '^', '[', '0', '>', '>', '>', '>', '^', '+', '0', '>', '>', '>', '>', '>', '^', '-', ']', '0', '>', '>', '>', '>', '+', '>', '+', '+', '0', '>', '>', '>', '>', '>', '^', '[', '0', '>', '[', '>', '^', '[', '>', '+', '<', '-', ']', '0', '>', '>', '-', '<', '-', ']', '0', '>', '>', '>', '>', '>', '^', '[', '0', '>', '>', '>', '>', '^', '+', '0', '>', '>', '>', '>', '>', '^', '-', ']', 'v', '0', '>', '>', '[', '-', ']', '>', '+', '>', '+', '>', '+', '+', '[', '0', '+', '>', '>', '+', '>', '>', '>', '-', ']', '0', '[', '>', '>', '>', '>', '>', '+', '0', '-', ']', '>', '>', '>', '[', '0', '+', '>', '+', '>', '>', '-', ']', '0', '[', '>', '>', '>', '+', '0', '-', ']', '>', '>', '>', '>', '>', '^', ']', '0', '>', '[', '>', '^', '[', '>', '+', '<', '-', ']', '0', '>', '>', '-', '<', '-', ']', '0', '>', '>', '>', '>', '>', '>', '[', '0', '>', '>', '^', '>', '+', '0', '>', '>', '>', '>', '>', '>', '-', ']', '0', '>', '>', '>', '[', '-', ']', '>', '[', '-', ']', '>', '[', '-', ']', '0', '>', '>', '^', '[', '>', ']', '>', '>', '[', '>', ']', '<', '[', '0', '>', '>', '>', '>', '+', '>', '>', '>', '[', '>', ']', '>', '>', '[', '>', ']', '<', '-', ']', '0', '>', '>', '^', '[', '>', ']', '>', '>', '[', '>', ']', '<', '[', '0', '>', '>', '>', '+', '>', '>', '>', '>', '[', '>', ']', '>', '>', '[', '>', ']', '<', '-', ']', '0', '>', '>', '^', '>', '[', '[', '>', ']', '<', '[', '>', '+', '<', '-', ']', '0', '>', '>', '^', '>', ']', '0', '>', '>', '>', '>', '>', '^', '>', '>', '[', '0', '>', '>', '>', '>', '>', '[', '>', '+', '0', '+', '>', '>', '>', '>', '>', '-', ']', '0', '[', '>', '>', '>', '>', '>', '+', '>', '+', '0', '-', ']', '>', '>', '>', '[', '0', '+', '>', '+', '>', '>', '-', ']', '0', '>', '[', '>', '>', '+', '<', '<', '-', ']', '0', '[', '>', '>', '>', '>', '>', '^', '>', '>', '-', '0', '-', ']', '>', '>', '>', '>', '>', '>', '[', '<', '^', '>', '>', '-', '0', '>', '>', '>', '>', '>', '>', '-', ']', '<', '+', '^', '>', '>', ']', '0', '>', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '[', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '[', '>', ']', '<', '[', '[', '>', '+', '<', '-', ']', '<', ']', '0', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '<', '[', '[', '>', '+', '<', '-', ']', '<', ']', '>', '+', '0', '>', '-', ']', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '>', '[', '[', '>', ']', '<', '[', '[', '>', '+', '<', '-', ']', '<', ']', '0', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '>', ']', '0', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '-', '<', ']', '<', '<', '[', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '+', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '<', '-', ']', '>', '[', '-', ']', '<', '<', '[', '-', ']', '<', '[', '-', ']', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '^', '>', '>', '[', '0', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '[', '0', '+', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '-', ']', '0', '[', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '+', '>', '+', '+', '0', '-', ']', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '0', '+', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '-', ']', '0', '[', '>', '+', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '+', '0', '-', ']', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '>', '[', '0', '>', '+', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '>', '-', ']', '0', '>', '+', '>', '>', '>', '>', '>', '>', '>', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '0', '>', '[', '[', '>', '>', '>', '>', '>', '+', '<', '<', '<', '<', '<', '<', '+', '>', '-', ']', '<', '[', '>', '+', '<', '-', ']', '>', '>', '>', '>', '+', '>', '>', '[', '-', '[', '-', '<', ']', '>', ']', '<', '<', '[', '-', '>', ']', '0', '>', '>', '>', '>', '[', '>', '>', '>', '>', '^', '+', '0', '>', '>', '>', '>', '-', ']', '>', '>', '>', '>', '-', '0', '>', '[', '[', '>', '>', '>', '>', '>', '+', '0', '+', '>', '-', ']', '0', '[', '>', '+', '<', '-', ']', '>', '>', '>', '>', '+', '>', '>', '[', '-', '[', '-', '<', ']', '>', ']', '<', '<', '[', '-', '>', ']', '0', '>', '>', '>', '>', '[', '0', '>', '>', '>', '+', '<', '-', '>', '>', '-', ']', '0', '>', '>', '+', '<', '-', ']', '>', '[', '<', '+', '>', '-', ']', '>', '[', '-', ']', '<', '<', ']', 'v', '0', '>', '>', '>', '>', '>', '>', '>', '>', '[', '-', ']', '+', '+', '+', '+', '+', '+', '+', '+', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '^', '>', '>', '[', '0', '>', '+', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '^', '>', '>', '-', ']', '0', '>', '-', '[', '[', '>', '>', '>', '>', '>', '+', '<', '<', '<', '<', '<', '<', '+', '>', '-', ']', '<', '[', '>', '+', '<', '-', ']', '>', '>', '>', '>', '+', '>', '>', '[', '-', '[', '-', '<', ']', '>', ']', '<', '<', '[', '-', '>', ']', '0', '>', '>', '>', '>', '[', '>', '>', '>', '>', '^', '+', '0', '>', '>', '>', '>', '-', ']', '>', '>', '>', '>', '-', '0', '>', '[', '[', '>', '>', '>', '>', '>', '+', '0', '+', '>', '-', ']', '0', '[', '>', '+', '<', '-', ']', '>', '>', '>', '>', '+', '>', '>', '[', '-', '[', '-', '<', ']', '>', ']', '<', '<', '[', '-', '>', ']', '0', '>', '>', '>', '>', '[', '0', '>', '>', '>', '+', '<', '-', '>', '>', '-', ']', '0', '>', '>', '+', '<', '-', ']', '>', '[', '<', '+', '>', '-', ']', '>', '[', '-', ']', '<', '<', ']', '0', '>', '>', '>', '>', '>', '>', '>', '+', '+', '+', '+', '+', '+', '+', '+', '>', '[', '-', ']', '+', '<', '[', '>', '^', '[', '0', '>', '+', '>', '>', '>', '>', '>', '>', '>', '^', '-', ']', '0', '>', '>', '>', '>', '>', '>', '>', '>', '^', '>', '>', '>', '>', '>', '>', '>', '>', '[', '0', '>', '+', '>', '>', '>', '>', '>', '>', '>', '^', '>', '>', '>', '>', '>', '>', '>', '>', '-', ']', '0', '>', '-', '[', '>', '-', '<', '<', ']', '0', '>', '>', '+', '<', '[', '-', ']', '>', '[', '>', '>', '>', '>', '>', '>', '^', '+', '0', '>', '>', '-', ']', '>', '>', '>', '>', '>', '>', '+', '<', '-', ']', '+', '+', '+', '+', '+', '+', '+', '+', '>', '[', '-', ']', '+', '<', '[', '>', '^', '[', '0', '>', '>', '>', '>', '>', '>', '>', '[', '<', '<', '+', '<', '<', '+', '>', '>', '>', '>', '-', ']', '<', '<', '<', '<', '[', '>', '>', '>', '>', '+', '<', '<', '<', '<', '-', ']', '>', '+', '>', '-', '[', '<', '[', '<', '+', '+', '>', '-', ']', '<', '[', '>', '+', '<', '-', ']', '>', '>', '-', ']', '<', '[', '>', '>', '+', '<', '<', '-', ']', '0', ']', '0', '>', '>', '>', '>', '>', '>', '>', '-', '>', '+', '<', ']', '0', '>', '>', '>', '>', '>', '>', '[', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '^', '>', '>', '+', '0', '>', '>', '>', '>', '>', '>', '-', ']', '0', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '-', ']', '<', '[', '-', ']', '<', '[', '-', ']', '<', '[', '-', ']', '<', '[', '-', ']', '<', '[', '-', ']', '<', '[', '-', ']', '<', '[', '-', ']', '<', '[', '-', ']', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '>', ']', '>', '+', '^', '>', '>', ']', '0', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '>', '[', '-', ']', '>', '>', '[', '>', ']', '>', '[', '-', ']', '>', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '<', '<', '[', '<', ']', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '0', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '[', '^', '>', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '0', '-', ']', '^', '>', '>', '[', '0', '+', '^', '>', '>', ']', '0', '^', '>', '>', '^', '>', '[', '0', '^', '>', '>', '+', '^', '>', ']', '0', '^', '>', '>', '[', '0', '>', '+', '<', '^', '>', '>', '-', ']', '0', '>', '[', '<', '-', '>', '-', ']', '>', '[', '>', ']', '>', '[', '>', ']', '<', '[', '>', '>', '+', '<', '<', '-', ']', '0', '[', '>', '>', '[', '>', ']', '>', '[', '>', ']', '>', '>', '[', '<', '+', '>', '-', ']', '0', '>', '>', '[', '>', ']', '<', '[', '>', '>', '[', '>', ']', '>', '>', '+', '0', '>', '>', '[', '>', ']', '<', '-', ']', '0', '>', '>', '[', '>', ']', '>', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '0', '-', ']', '>', '>', '>', '[', '[', '>', ']', '<', '[', '>', '>', '[', '>', ']', '>', '+', '<', '<', '[', '<', ']', '<', '-', ']', '>', '>', '[', '>', ']', '<', '[', '>', '+', '<', '-', ']', '<', '[', '<', ']', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '0', '>', '>', '>', ']', '>', '>', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '0', '>', '>', '>', '>', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '0', '>', '>', '>', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '0', '>', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']', '0', '>', '[', '[', '<', '+', '>', '-', ']', '>', ']'};
+// Whether a move can stand in for its loop with the counter in cell ptr
+static int bf_move_fits(const bf_instruction *ins, int ptr) {
+    if (ins->op == BF_MOVE_AT) {
+        return ptr == ins->b;
+    }
+    for (uint8_t i = 1; i <= ins->a; i++) {
+        int cell = ptr + ins[i].b;
+        if (cell < 0 || cell >= TAPE_SIZE) return 0;
+    }
+    return 1;
+}
 
+void bf_decrypt(uint8_t *encrypted_arr, uint8_t size) {
+    uint32_t start = profile_start();
     unsigned char tape[TAPE_SIZE] = {0};
-    unsigned char *ptr = tape;
-    const char *loop_start;
-    const char *loop_stack[STACK_SIZE];
-    int loop_stack_index = 0;
+    int ptr = 0;
+    uint16_t pc = 0;
 
     load_tape(tape, encrypted_arr, size);
 
-    uint32_t code_index = 0;
-
-    while (code[code_index] != '\0') {
-        char instruction = code[code_index];
-        switch (instruction) {
-            case '>':
-                ptr++;
-                if (ptr >= tape + TAPE_SIZE) ptr = tape; // wrap around
+    while (bf_program[pc].op != BF_END) {
+        const bf_instruction *ins = &bf_program[pc++];
+        switch (ins->op) {
+            case BF_RIGHT:
+                ptr = (ptr + ins->a) % TAPE_SIZE; // wrap around
                 break;
-            case '<':
-                if (ptr != tape){
-                    ptr--;
-                }
+            case BF_LEFT:
+                ptr = ptr > ins->a ? ptr - ins->a : 0;
                 break;
-            case '+':
-                (*ptr)++;
+            case BF_ADD:
+                tape[ptr] += ins->a;
                 break;
-            case '-':
-                (*ptr)--;
+            case BF_SET:
+                ptr = ins->a;
                 break;
-            case '0':
-                ptr = tape;
+            case BF_UP:
+                ptr += tape[ptr];
                 break;
-            case '^':
-                ptr += *ptr;
+            case BF_DOWN:
+                ptr -= tape[ptr];
                 break;
-            case 'v':
-                ptr -= *ptr;
+            case BF_OPEN:
+                if (tape[ptr] == 0) pc = ins->b;
                 break;
-            case '[':
-                if (*ptr == 0) {
-                    int loop_count = 1;
-                    while (loop_count > 0) {
-                        code_index++;
-                        if (code[code_index] == '[') loop_count++;
-                        if (code[code_index] == ']') loop_count--;
-                    }
-                } else {
-                    loop_stack[loop_stack_index++] = &code[code_index];
-                }
+            case BF_CLOSE:
+                if (tape[ptr] != 0) pc = ins->b;
                 break;
-            case ']':
-                if (*ptr != 0) {
-                    code_index = loop_stack[loop_stack_index - 1] - code;
-                } else {
-                    loop_stack_index--;
+            case BF_CLEAR:
+                tape[ptr] = 0;
+                break;
+            case BF_SCAN_RIGHT:
+                while (tape[ptr] != 0) ptr = (ptr + ins->a) % TAPE_SIZE;
+                break;
+            case BF_SCAN_LEFT:
+                while (tape[ptr] != 0) ptr = ptr > ins->a ? ptr - ins->a : 0;
+                break;
+            case BF_MOVE:
+            case BF_MOVE_AT:
+                // The loop after the targets finds a zero counter and is skipped
+                if (bf_move_fits(ins, ptr)) {
+                    for (uint8_t i = 1; i <= ins->a; i++) {
+                        tape[ptr + ins[i].b] += tape[ptr] * ins[i].a;
+                    }
+                    tape[ptr] = 0;
                 }
+                pc += ins->a;
                 break;
             default:
                 break;
         }
-        code_index++;
-
-
     }
 
-
     save_tape(tape, encrypted_arr, size);
-    
+    profile_end(PROFILE_BF_DECRYPT, start);
 }
-
-
-   
-
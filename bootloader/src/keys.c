@@ -0,0 +1,121 @@
+#include "bootloader.h"
+#include "keys.h"
+#include "secrets.h"
+#include "secret_partition.h"
+#include "bf.h"
+#include "uart/uart.h"
+
+// Hardware Imports
+#include "inc/hw_memmap.h"    // Peripheral Base Addresses
+#include "inc/hw_types.h"     // Boolean type
+#include "inc/tm4c123gh6pm.h" // Peripheral Bit Masks and Registers
+
+// Driver API Imports
+#include "driverlib/sysctl.h"    // System control API (clock/reset)
+#include "driverlib/uart.h"
+
+#include "driverlib/eeprom.h"	 // EEPROM API
+
+#define HMAC_IPAD 0x36
+#define HMAC_OPAD 0x5c
+
+// Longer keys would have to be hashed first
+#if SECRETS_HMAC_KEY_LEN > WC_SHA256_BLOCK_SIZE
+#error "HMAC key does not fit in a SHA256 block"
+#endif
+
+// Placed by the linker script, see keys.h
+static key_context keys __attribute__((section(".keys")));
+
+static void keys_zero(volatile uint8_t *p, uint32_t len) {
+	while (len--) {
+		*p++ = 0;
+	}
+}
+
+// Hashes the padded key into both midstates
+static int keys_hmac_setup(const uint8_t *key) {
+	uint8_t pad[WC_SHA256_BLOCK_SIZE];
+	int ret;
+
+	for (uint32_t i = 0; i < sizeof(pad); i++) {
+		pad[i] = (i < SECRETS_HMAC_KEY_LEN ? key[i] : 0) ^ HMAC_IPAD;
+	}
+	ret = wc_InitSha256(&keys.inner) || wc_Sha256Update(&keys.inner, pad, sizeof(pad));
+
+	for (uint32_t i = 0; i < sizeof(pad); i++) {
+		pad[i] ^= HMAC_IPAD ^ HMAC_OPAD;
+	}
+	ret = ret || wc_InitSha256(&keys.outer) || wc_Sha256Update(&keys.outer, pad, sizeof(pad));
+
+	keys_zero((volatile uint8_t *) pad, sizeof(pad));
+	return ret;
+}
+
+// Must run after setup_secrets, it hides the secrets block until the next reset
+void keys_setup(void) {
+	secrets_struct secrets;
+
+	// Read secrets from EEPROM and hide block, preventing further access
+	EEPROMRead((uint32_t *) &secrets, SECRETS_EEPROM_OFFSET, sizeof(secrets));
+	EEPROMBlockHide(EEPROMBlockFromAddr(SECRETS_EEPROM_OFFSET));
+	bf_decrypt(secrets.hmac_key, SECRETS_HMAC_KEY_LEN);
+	bf_decrypt(secrets.decrypt_key, SECRETS_DECRYPT_KEY_LEN);
+
+	if (wc_AesInit(&keys.aes, NULL, INVALID_DEVID)) {
+		uart_write_str(UART0, "FATAL aes initialization error\n");
+		while(UARTBusy(UART0_BASE)){}
+		SysCtlReset();
+	}
+
+	// Direction for some modes (CFB and CTR) is always AES_ENCRYPTION.
+	if (wc_AesSetKey(&keys.aes, secrets.decrypt_key, sizeof(secrets.decrypt_key), NULL, AES_ENCRYPTION)) {
+		uart_write_str(UART0, "FATAL aes key setup error\n");
+		while(UARTBusy(UART0_BASE)){}
+		SysCtlReset();
+	}
+
+	if (keys_hmac_setup(secrets.hmac_key) != 0) {
+		uart_write_str(UART0, "Couldn't init HMAC");
+		while(UARTBusy(UART0_BASE)){}
+		SysCtlReset();
+	}
+
+	keys_zero((volatile uint8_t *) &secrets, sizeof(secrets));
+}
+
+// Fresh CTR state from the cached key schedule
+void keys_aes(Aes *aes, const uint8_t *iv) {
+	*aes = keys.aes;
+	if (wc_AesSetIV(aes, iv)) {
+		uart_write_str(UART0, "FATAL aes key setup error\n");
+		while(UARTBusy(UART0_BASE)){}
+		SysCtlReset();
+	}
+}
+
+// Starts a MAC, the message goes in with wc_Sha256Update
+int keys_hmac(wc_Sha256 *sha) {
+	return wc_Sha256Copy(&keys.inner, sha);
+}
+
+// Finishes the inner hash and runs it through the outer one
+int keys_hmac_final(wc_Sha256 *sha, uint8_t *mac) {
+	wc_Sha256 outer;
+	uint8_t inner[WC_SHA256_DIGEST_SIZE];
+	int ret;
+
+	ret = wc_Sha256Final(sha, inner) ||
+		wc_Sha256Copy(&keys.outer, &outer) ||
+		wc_Sha256Update(&outer, inner, sizeof(inner)) ||
+		wc_Sha256Final(&outer, mac);
+
+	// Both are derived from the key, same as the section keys_wipe clears
+	keys_zero((volatile uint8_t *) inner, sizeof(inner));
+	keys_zero((volatile uint8_t *) &outer, sizeof(outer));
+	return ret;
+}
+
+void keys_wipe(void) {
+	keys_zero((volatile uint8_t *) &keys, sizeof(keys));
+}
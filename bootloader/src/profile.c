@@ -0,0 +1,144 @@
+#include "bootloader.h"
+#include "profile.h"
+#include "uart/uart.h"
+
+#include "inc/hw_memmap.h"    // Peripheral Base Addresses
+#include "inc/hw_types.h"     // Boolean type
+#include "inc/tm4c123gh6pm.h" // Peripheral Bit Masks and Registers
+
+#include "driverlib/sysctl.h"
+
+#ifdef BOOTLOADER_HOST
+#include <time.h>
+#endif
+
+#define PROFILE_MAGIC 0x50524F46
+
+#ifdef BOOTLOADER_PROFILE
+
+static const char * const profile_names[PROFILE_REGIONS] = {
+	"read_frame",
+	"verify_checksum",
+	"program_flash",
+	"wc_AesCtrEncrypt",
+	"verify_hmac",
+	"compute_boot_tag",
+	"wc_ed25519_verify_msg",
+	"bf_decrypt",
+	"bass_crypt",
+	"copy_fw_to_ram"
+};
+
+// Startup code does not clear .noinit, so the table survives the reset at the end of an update
+static struct {
+	uint32_t magic;
+	profile_entry entries[PROFILE_REGIONS];
+} profile_table __attribute__((section(".noinit")));
+
+void profile_init(void) {
+#ifndef BOOTLOADER_HOST
+	PROFILE_DEMCR |= PROFILE_DEMCR_TRCENA;
+	PROFILE_DWT_CYCCNT = 0;
+	PROFILE_DWT_CTRL |= PROFILE_DWT_CTRL_CYCCNTENA;
+#endif
+
+	// Anything else is left over from before power on
+	if (profile_table.magic != PROFILE_MAGIC) {
+		for (uint32_t i = 0; i < PROFILE_REGIONS; i++) {
+			profile_table.entries[i].count = 0;
+			profile_table.entries[i].min = 0xFFFFFFFF;
+			profile_table.entries[i].max = 0;
+			profile_table.entries[i].total = 0;
+		}
+		profile_table.magic = PROFILE_MAGIC;
+	}
+}
+
+#ifdef BOOTLOADER_HOST
+uint32_t profile_start(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+#endif
+
+void profile_end(enum PROFILE_REGION region, uint32_t start) {
+	// Unsigned subtraction still works if the counter wrapped once
+	uint32_t cycles = profile_start() - start;
+	profile_entry *entry = &profile_table.entries[region];
+
+	entry->count++;
+	entry->total += cycles;
+	if (cycles < entry->min) {
+		entry->min = cycles;
+	}
+	if (cycles > entry->max) {
+		entry->max = cycles;
+	}
+}
+
+/*
+ * Dump format, numbers are 8 hex digits:
+ * P <cycles per second>
+ * <region> <count> <min> <max> <total high word> <total low word>
+ * ...
+ * followed by an empty line. Regions that never ran are left out. When booting
+ * the table ends at the empty line bass_crypt prints, and copy_fw_to_ram (its
+ * AES time) and bass_crypt (the rest) follow its output as a second block (see
+ * boot_firmware).
+ */
+void profile_dump(uint8_t uart) {
+	profile_dump_start(uart);
+	nl(uart);
+}
+
+static void profile_dump_line(uint8_t uart, enum PROFILE_REGION region, uint32_t count, uint32_t min, uint32_t max, uint64_t total) {
+	uart_write_str(uart, (char *) profile_names[region]);
+	uart_write_str(uart, " ");
+	uart_write_hex(uart, count);
+	uart_write_str(uart, " ");
+	uart_write_hex(uart, min);
+	uart_write_str(uart, " ");
+	uart_write_hex(uart, max);
+	uart_write_str(uart, " ");
+	uart_write_hex(uart, (uint32_t) (total >> 32));
+	uart_write_str(uart, " ");
+	uart_write_hex(uart, (uint32_t) total);
+	nl(uart);
+}
+
+// Everything but the closing empty line
+void profile_dump_start(uint8_t uart) {
+	uart_write_str(uart, "P ");
+#ifdef BOOTLOADER_HOST
+	uart_write_hex(uart, 1000000000);
+#else
+	uart_write_hex(uart, SysCtlClockGet());
+#endif
+	nl(uart);
+
+	for (uint32_t i = 0; i < PROFILE_REGIONS; i++) {
+		profile_entry *entry = &profile_table.entries[i];
+		if (entry->count) {
+			profile_dump_line(uart, i, entry->count, entry->min, entry->max, entry->total);
+		}
+	}
+}
+
+// A single measurement that was kept out of the table
+void profile_dump_sample(uint8_t uart, enum PROFILE_REGION region, uint32_t cycles) {
+	profile_dump_line(uart, region, 1, cycles, cycles, cycles);
+}
+
+#else
+
+// Empty table, the updater can tell profiling is compiled out
+void profile_dump(uint8_t uart) {
+	uart_write_str(uart, "P ");
+	uart_write_hex(uart, 0);
+	nl(uart);
+	nl(uart);
+}
+
+#endif
@@ -64,7 +64,8 @@ void setup_secrets(void) {
 			STORAGE_TRUST_NONE,
 			1,
 			0,
-			0
+			0,
+			{0}
 		};
 
 		//store vault in EEPROM
@@ -36,6 +36,13 @@ static void NmiSR(void);
 static void FaultISR(void);
 static void IntDefaultHandler(void);
 
+//*****************************************************************************
+//
+// External declarations for the interrupt handlers used by the application.
+//
+//*****************************************************************************
+extern void UART0_IRQHandler(void);
+
 //*****************************************************************************
 //
 // The entry point for the application.
@@ -79,7 +86,7 @@ __attribute__((section(".isr_vector"))) void (*const g_pfnVectors[])(void) = {
     IntDefaultHandler, // GPIO Port C
     IntDefaultHandler, // GPIO Port D
     IntDefaultHandler, // GPIO Port E
-    IntDefaultHandler, // UART0 Rx and Tx
+    UART0_IRQHandler,  // UART0 Rx and Tx
     IntDefaultHandler, // UART1 Rx and Tx
     IntDefaultHandler, // SSI0 Rx and Tx
     IntDefaultHandler, // I2C0 Master and Slave
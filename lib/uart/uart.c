@@ -8,16 +8,31 @@
 #include "inc/tm4c123gh6pm.h" // Peripheral Bit Masks and Registers
 #include "inc/hw_types.h" // Boolean type
 #include "inc/hw_gpio.h" // GPIO macros (for UART initialization)
+#include "inc/hw_uart.h" // UART register offsets (for uDMA)
 
 // Driver API Imports
 #include "driverlib/uart.h" // UART API
 #include "driverlib/sysctl.h" // Stystem Control API (clock/reset)
 #include "driverlib/gpio.h" // GPIO (for UART setup)
 #include "driverlib/pin_map.h"
+#include "driverlib/interrupt.h" // Interrupt API
+#include "driverlib/udma.h" // uDMA API
 
 // Application Imports
 #include "uart.h"
 
+// Single producer single consumer receive ring for UART0
+// head is only written by UART0_IRQHandler and tail only by readers, so no locking is needed
+static volatile uint8_t uart_rx_ring[UART_RX_RING_SIZE];
+static volatile uint32_t uart_rx_head = 0;
+static volatile uint32_t uart_rx_tail = 0;
+static bool uart_rx_ring_enabled = false;
+
+// uDMA channel control table, the controller requires it to be 1024 byte aligned
+static uint8_t uart_dma_table[1024] __attribute__((aligned(1024)));
+static bool uart_dma_initialized = false;
+static volatile bool uart_rx_dma_active = false;
+
 void uart_init(uint8_t uart)
 {
   unsigned long uart_base;
@@ -38,7 +53,7 @@ void uart_init(uint8_t uart)
   }
 
   UARTDisable(uart_base);
-  UARTConfigSetExpClk(uart_base, SysCtlClockGet(), 115200, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+  UARTConfigSetExpClk(uart_base, SysCtlClockGet(), UART_DEFAULT_BAUD, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
   if (rx_int_enable) UARTIntEnable(uart_base, UART_INT_RX);
   UARTEnable(uart_base);
 }
@@ -58,12 +73,229 @@ void initialize_uarts(){
   // Use the internal 16MHz oscillator as the UART clock source.
   UARTClockSourceSet(UART0_BASE, UART_CLOCK_PIOSC);
 
-  UARTConfigSetExpClk(UART0_BASE, SysCtlClockGet(), 115200, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+  UARTConfigSetExpClk(UART0_BASE, UART_PIOSC_FREQ, UART_DEFAULT_BAUD, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+}
+
+// Change the baud rate of an initialized UART, waits for pending output first
+// Interrupt and FIFO level settings are kept
+void uart_set_baud(uint8_t uart, uint32_t baud)
+{
+  unsigned long uart_base;
+  uint32_t clock;
+
+  switch (uart){
+    case UART0:
+      uart_base = UART0_BASE;
+      break;
+    case UART1:
+      uart_base = UART1_BASE;
+      break;
+    case UART2:
+      uart_base = UART2_BASE;
+      break;
+    default:
+      return;
+  }
+
+  clock = SysCtlClockGet();
+  if (UARTClockSourceGet(uart_base) == UART_CLOCK_PIOSC) {
+    clock = UART_PIOSC_FREQ;
+  }
+
+  while (UARTBusy(uart_base)) {
+  }
+  UARTConfigSetExpClk(uart_base, clock, baud, (UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE));
+}
+
+// Start buffering UART0 receive data from the RX interrupt, only UART0 has a ring
+void uart_rx_enable(uint8_t uart)
+{
+  if (uart != UART0) {
+    return;
+  }
+
+  uart_rx_head = 0;
+  uart_rx_tail = 0;
+  uart_rx_ring_enabled = true;
+
+  // Interrupt at half full, the receive timeout interrupt picks up anything less
+  UARTFIFOLevelSet(UART0_BASE, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+  UARTIntClear(UART0_BASE, UART_INT_RX | UART_INT_RT);
+  UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+  IntEnable(INT_UART0);
+  IntMasterEnable();
+}
+
+// Stop buffering, must be called before the ring's memory is handed to anything else
+void uart_rx_disable(uint8_t uart)
+{
+  if (uart != UART0) {
+    return;
+  }
+
+  IntDisable(INT_UART0);
+  UARTIntDisable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+  uart_rx_ring_enabled = false;
+
+  // The control table is in SRAM too, stop the controller from writing anywhere
+  if (uart_rx_dma_active) {
+    uDMAChannelDisable(UDMA_CHANNEL_UART0RX);
+    UARTDMADisable(UART0_BASE, UART_DMA_RX);
+    uart_rx_dma_active = false;
+  }
+  if (uart_dma_initialized) {
+    uDMADisable();
+    uart_dma_initialized = false;
+  }
+}
+
+// Copy up to len bytes that are already waiting, never blocks
+static uint32_t uart_rx_take(uint8_t uart, unsigned long uart_base, uint8_t *buf, uint32_t len)
+{
+  uint32_t n = 0;
+
+  if (uart == UART0 && uart_rx_ring_enabled) {
+    uint32_t head = uart_rx_head;
+    uint32_t tail = uart_rx_tail;
+    while (tail != head && n < len) {
+      buf[n++] = uart_rx_ring[tail];
+      tail = (tail + 1) & (UART_RX_RING_SIZE - 1);
+    }
+    uart_rx_tail = tail;
+    return n;
+  }
+
+  while (n < len && UARTCharsAvail(uart_base)) {
+    buf[n++] = UARTCharGetNonBlocking(uart_base) & 0xFF;
+  }
+  return n;
+}
+
+// Read len bytes into buf, giving up after roughly timeout milliseconds
+// A timeout of 0 only takes what is already waiting, UART_WAIT_FOREVER blocks until len bytes arrived
+// Returns the number of bytes read
+uint32_t uart_read_block(uint8_t uart, uint8_t *buf, uint32_t len, uint32_t timeout)
+{
+  unsigned long uart_base;
+  uint32_t got = 0;
+  uint32_t n;
+  uint32_t delay = 0;
+  uint32_t waited = 0;
+
+  switch (uart){
+    case UART0:
+      uart_base = UART0_BASE;
+      break;
+    case UART1:
+      uart_base = UART1_BASE;
+      break;
+    case UART2:
+      uart_base = UART2_BASE;
+      break;
+    default:
+      return 0;
+  }
+
+  while (got < len) {
+    n = uart_rx_take(uart, uart_base, buf + got, len - got);
+    got += n;
+    if (n || timeout == UART_WAIT_FOREVER) {
+      continue;
+    }
+
+    // Nothing waiting, sleep in 100us steps until the timeout runs out
+    if (waited >= timeout * 10) {
+      break;
+    }
+    if (delay == 0) {
+      // SysCtlDelay takes 3 cycles per count
+      delay = SysCtlClockGet() / 30000;
+    }
+    SysCtlDelay(delay);
+    waited++;
+  }
+  return got;
+}
+
+// Hand the receive path back to the ring once the uDMA transfer has stopped
+// Called from UART0_IRQHandler and from uart_rx_dma_done
+static void uart_rx_dma_check(void)
+{
+  if (!uart_rx_dma_active || uDMAChannelModeGet(UDMA_CHANNEL_UART0RX | UDMA_PRI_SELECT) != UDMA_MODE_STOP) {
+    return;
+  }
+
+  UARTDMADisable(UART0_BASE, UART_DMA_RX);
+  uart_rx_dma_active = false;
+  UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+}
+
+// Receive len bytes of UART0 straight into buf, at most 1024 bytes per transfer
+// Bytes already in the receive ring are copied first and the uDMA controller is armed for the rest
+// Poll uart_rx_dma_done to find out when buf is complete, other reads must wait until then
+// Without a receive ring this falls back to a blocking read
+void uart_rx_dma_start(uint8_t uart, uint8_t *buf, uint32_t len)
+{
+  uint32_t n;
+
+  if (uart != UART0 || !uart_rx_ring_enabled) {
+    uart_read_block(uart, buf, len, UART_WAIT_FOREVER);
+    return;
+  }
+
+  // Keep the ISR out of the FIFO while the ring is emptied, the controller takes over from there
+  UARTIntDisable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+  n = uart_rx_take(uart, UART0_BASE, buf, len);
+  if (n == len) {
+    UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+    return;
+  }
+
+  if (!uart_dma_initialized) {
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA)) {
+    }
+    uDMAEnable();
+    uDMAControlBaseSet(uart_dma_table);
+    uDMAChannelAssign(UDMA_CH8_UART0RX);
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_UART0RX, UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST | UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+    // Arbitration matches the RX FIFO interrupt level, leftovers come in as single requests
+    uDMAChannelControlSet(UDMA_CHANNEL_UART0RX | UDMA_PRI_SELECT, UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_4);
+    uart_dma_initialized = true;
+  }
+
+  uDMAChannelTransferSet(UDMA_CHANNEL_UART0RX | UDMA_PRI_SELECT, UDMA_MODE_BASIC, (void *)(UART0_BASE + UART_O_DR), buf + n, len - n);
+  uart_rx_dma_active = true;
+  uDMAChannelEnable(UDMA_CHANNEL_UART0RX);
+  UARTDMAEnable(UART0_BASE, UART_DMA_RX);
+}
+
+// Returns true once the buffer given to uart_rx_dma_start has been filled
+bool uart_rx_dma_done(uint8_t uart)
+{
+  bool done;
+
+  if (uart != UART0) {
+    return true;
+  }
+
+  IntDisable(INT_UART0);
+  uart_rx_dma_check();
+  done = !uart_rx_dma_active;
+  IntEnable(INT_UART0);
+  return done;
 }
 
 uint8_t uart_read(uint8_t uart, int blocking, int *read)
 {
   unsigned long uart_base;
+  uint8_t c = 0;
+
+  if (uart == UART0 && uart_rx_ring_enabled) {
+    *read = uart_read_block(uart, &c, 1, blocking ? UART_WAIT_FOREVER : 0);
+    return c;
+  }
+
   switch (uart){
     case UART0:
       uart_base = UART0_BASE;
@@ -138,11 +370,35 @@ void uart_write_hex(uint8_t uart, uint32_t data) {
   }
 }
 
-// UART0 ISR : Reset if received 0x20
+// UART0 ISR : Fill the receive ring, or reset if received 0x20 when there is no ring
 void UART0_IRQHandler(void)
 {
-  UARTIntClear(UART0_BASE, UART_INT_RX);
-  if (UARTCharGet(UART0_BASE) == RESET_SYMBOL){
-    SysCtlReset();
+  uint32_t next;
+  uint8_t c;
+
+  if (!uart_rx_ring_enabled) {
+    UARTIntClear(UART0_BASE, UART_INT_RX);
+    if (UARTCharGet(UART0_BASE) == RESET_SYMBOL){
+      SysCtlReset();
+    }
+    return;
+  }
+
+  // The uDMA controller signals completion on this vector as well
+  uart_rx_dma_check();
+  if (uart_rx_dma_active) {
+    return;
+  }
+
+  UARTIntClear(UART0_BASE, UART_INT_RX | UART_INT_RT);
+  while (UARTCharsAvail(UART0_BASE)) {
+    c = UARTCharGetNonBlocking(UART0_BASE) & 0xFF;
+    next = (uart_rx_head + 1) & (UART_RX_RING_SIZE - 1);
+    // Ring is full, drop the byte and let the frame checksum catch it
+    if (next == uart_rx_tail) {
+      continue;
+    }
+    uart_rx_ring[uart_rx_head] = c;
+    uart_rx_head = next;
   }
 }
\ No newline at end of file
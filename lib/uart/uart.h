@@ -13,12 +13,29 @@
 // Device control
 #define RESET_SYMBOL 0x20
 
+// Link settings, UART0 is clocked from the 16MHz PIOSC regardless of the system clock
+#define UART_DEFAULT_BAUD 115200
+#define UART_PIOSC_FREQ 16000000
+
+// Interrupt fed receive ring for UART0, size must be a power of two
+#define UART_RX_RING_SIZE 1024
+
+// uart_read_block timeout that never gives up
+#define UART_WAIT_FOREVER 0xFFFFFFFF
+
 // Types
 #include <stdint.h>
+#include <stdbool.h>
 
 // Function prototypes
 void uart_init(uint8_t uart);
+void uart_set_baud(uint8_t uart, uint32_t baud);
 uint8_t uart_read(uint8_t uart, int blocking, int *read);
+uint32_t uart_read_block(uint8_t uart, uint8_t *buf, uint32_t len, uint32_t timeout);
+void uart_rx_enable(uint8_t uart);
+void uart_rx_disable(uint8_t uart);
+void uart_rx_dma_start(uint8_t uart, uint8_t *buf, uint32_t len);
+bool uart_rx_dma_done(uint8_t uart);
 void uart_write(uint8_t uart, uint32_t data);
 void uart_write_hex(uint8_t uart, uint32_t data);
 void uart_write_str(uint8_t uart, char *str);
@@ -0,0 +1,189 @@
+// Copyright 2024 The MITRE Corporation. ALL RIGHTS RESERVED
+// Approved for public release. Distribution unlimited 23-02181-25.
+
+/*
+ * UART driver for the host simulator.
+ * UART0 is a pseudo terminal that fw_update.py can open like the board's
+ * serial port, UART1 and UART2 go to stdout.
+ */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include "uart.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <termios.h>
+
+static int uart0_master = -1;
+static int uart0_slave = -1;
+
+// Opens the pty behind UART0 and prints its name, link is an optional symlink to it
+int uart_host_open(const char *link)
+{
+  struct termios tio;
+  const char *name;
+
+  if (uart0_master >= 0) {
+    return 0;
+  }
+
+  uart0_master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (uart0_master < 0 || grantpt(uart0_master) || unlockpt(uart0_master)) {
+    perror("uart: pty");
+    return -1;
+  }
+  name = ptsname(uart0_master);
+
+  // Keep the slave open so the pty survives the updater closing it
+  uart0_slave = open(name, O_RDWR | O_NOCTTY);
+  if (uart0_slave < 0 || tcgetattr(uart0_slave, &tio)) {
+    perror(name);
+    return -1;
+  }
+  cfmakeraw(&tio);
+  tcsetattr(uart0_slave, TCSANOW, &tio);
+
+  if (link) {
+    unlink(link);
+    if (symlink(name, link)) {
+      perror(link);
+      return -1;
+    }
+  }
+  fprintf(stderr, "uart: UART0 is %s\n", link ? link : name);
+  return 0;
+}
+
+void uart_init(uint8_t uart)
+{
+}
+
+void initialize_uarts()
+{
+  uart_host_open(NULL);
+}
+
+void uart_set_baud(uint8_t uart, uint32_t baud)
+{
+  return;
+}
+
+void uart_rx_enable(uint8_t uart)
+{
+  return;
+}
+
+void uart_rx_disable(uint8_t uart)
+{
+  return;
+}
+
+static uint64_t uart_now_ms(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+uint32_t uart_read_block(uint8_t uart, uint8_t *buf, uint32_t len, uint32_t timeout)
+{
+  struct pollfd pfd;
+  uint64_t deadline = uart_now_ms() + timeout;
+  uint32_t got = 0;
+  int wait;
+  ssize_t n;
+
+  if (uart != UART0 || uart0_master < 0) {
+    return 0;
+  }
+
+  pfd.fd = uart0_master;
+  pfd.events = POLLIN;
+  while (got < len) {
+    if (timeout == UART_WAIT_FOREVER) {
+      wait = -1;
+    } else {
+      uint64_t now = uart_now_ms();
+      wait = now >= deadline ? 0 : (int) (deadline - now);
+    }
+
+    n = poll(&pfd, 1, wait);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    n = read(uart0_master, buf + got, len - got);
+    if (n <= 0) {
+      if (n < 0 && (errno == EINTR || errno == EAGAIN)) {
+        continue;
+      }
+      break;
+    }
+    got += n;
+  }
+  return got;
+}
+
+uint8_t uart_read(uint8_t uart, int blocking, int *read)
+{
+  uint8_t c = 0;
+
+  *read = uart_read_block(uart, &c, 1, blocking ? UART_WAIT_FOREVER : 0);
+  return c;
+}
+
+void uart_rx_dma_start(uint8_t uart, uint8_t *buf, uint32_t len)
+{
+  uart_read_block(uart, buf, len, UART_WAIT_FOREVER);
+}
+
+bool uart_rx_dma_done(uint8_t uart)
+{
+  return true;
+}
+
+void uart_write(uint8_t uart, uint32_t data)
+{
+  uint8_t c = data & 0xFF;
+
+  if (uart != UART0) {
+    putc(c, stdout);
+    fflush(stdout);
+    return;
+  }
+  if (uart0_master >= 0 && write(uart0_master, &c, 1) != 1) {
+    perror("uart: write");
+  }
+}
+
+void uart_write_str(uint8_t uart, char *str)
+{
+  while (*str) {
+    uart_write(uart, (uint32_t) *str++);
+  }
+}
+
+void nl(uint8_t uart)
+{
+  uart_write(uart, '\n');
+}
+
+void uart_write_hex(uint8_t uart, uint32_t data)
+{
+  char buf[9];
+
+  snprintf(buf, sizeof(buf), "%08X", data);
+  uart_write_str(uart, buf);
+}
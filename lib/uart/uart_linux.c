@@ -42,6 +42,50 @@ uint8_t uart_read(uint8_t uart, int blocking, int *read)
 }
 
 
+uint32_t uart_read_block(uint8_t uart, uint8_t *buf, uint32_t len, uint32_t timeout)
+{
+  int read;
+
+  for (uint32_t i = 0; i < len; i++) {
+    buf[i] = uart_read(uart, timeout ? BLOCKING : NONBLOCKING, &read);
+    if (!read) {
+      return i;
+    }
+  }
+  return len;
+}
+
+
+void uart_set_baud(uint8_t uart, uint32_t baud)
+{
+  return;
+}
+
+
+void uart_rx_enable(uint8_t uart)
+{
+  return;
+}
+
+
+void uart_rx_disable(uint8_t uart)
+{
+  return;
+}
+
+
+void uart_rx_dma_start(uint8_t uart, uint8_t *buf, uint32_t len)
+{
+  uart_read_block(uart, buf, len, UART_WAIT_FOREVER);
+}
+
+
+bool uart_rx_dma_done(uint8_t uart)
+{
+  return true;
+}
+
+
 void uart_write_str(uint8_t uart, char* str)
 {
   if (uart != UART2 || !uart2_initialized)
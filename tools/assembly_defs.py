@@ -25,5 +25,8 @@ opcodes = {"mov": 0x39,
 syscodes = {
         "sw": 0x10,
         "sr": 0x20,
-        "sx": 0x30
+        "sx": 0x30,
+        "sbw": 0x11,
+        "sbr": 0x21,
+        "sbx": 0x40
         }
@@ -27,6 +27,10 @@ COMP_XOR_CODE = 0x53
 COMP_SYS_WRITE = 0x10
 COMP_SYS_READ = 0x20
 COMP_SYS_EXIT = 0x30
+# Block syscalls, a and b are memory addresses and rb is the length in bytes
+COMP_SYS_WRITE_BLOCK = 0x11
+COMP_SYS_READ_BLOCK = 0x21
+COMP_SYS_XOR_BLOCK = 0x40
 
 COMP_FLAG_SIGN_SHIFT = 0
 COMP_FLAG_CARRY_SHIFT = 1
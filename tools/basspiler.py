@@ -0,0 +1,191 @@
+#!/usr/bin/env python
+
+"""
+BASS to C Translator
+
+Compiles a .dumbbass program into a C function, bass_native, that does what
+computer_interpret_program in bootloader/src/computer.c does with the
+assembled program: same registers, flags, memory, syscalls and exit code,
+starting at ip 0. Every instruction slot becomes a few lines of C, jumps
+become gotos and registers live in locals until a syscall or the end.
+
+The translation works on the assembled bytes, so whatever the interpreter
+would reject (bad opcodes, bad registers, running off the end of the
+program) still resets the board when it is reached.
+
+Usage: basspiler.py <infile> <outfile>
+e.g. python basspiler.py bananaaa.dumbbass ../bootloader/src/bass_native.c
+"""
+
+import sys
+
+import basscodes
+from bassembler import assemble
+
+SLOTS = 256
+
+REGISTERS = {basscodes.COMP_RA_MASK: "ra",
+             basscodes.COMP_RB_MASK: "rb",
+             basscodes.COMP_RC_MASK: "rc",
+             basscodes.COMP_RD_MASK: "rd",
+             basscodes.COMP_RE_MASK: "re",
+             basscodes.COMP_RF_MASK: "rf"}
+
+# Opcode to C statement, {a} and {b} are register locals
+REG_OPS = {basscodes.COMP_MOV_CODE: "{a} = {b};",
+           basscodes.COMP_ADD_CODE: "{a} += {b};",
+           basscodes.COMP_SUB_CODE: "{a} -= {b};",
+           basscodes.COMP_CMP_CODE: "fl = computer_cmp_flags({a}, {b});",
+           basscodes.COMP_STM_CODE: "state->memory[{a}] = {b};",
+           basscodes.COMP_LDM_CODE: "{a} = state->memory[{b}];",
+           basscodes.COMP_AND_CODE: "{a} &= {b};",
+           basscodes.COMP_NOT_CODE: "{a} = !{b};",
+           basscodes.COMP_ORR_CODE: "{a} |= {b};",
+           basscodes.COMP_XOR_CODE: "{a} ^= {b};"}
+
+# Opcodes that never fall through to the next slot
+TERMINAL = {basscodes.COMP_JMP_CODE, basscodes.COMP_JLT_CODE}
+
+
+def slots(program):
+    program = program + bytes(SLOTS * 3 - len(program))
+    return [tuple(program[i * 3: i * 3 + 3]) for i in range(SLOTS)]
+
+
+def is_bad(opcode, a, b):
+    # Mirrors computer_decode_program
+    if opcode in REG_OPS or opcode == basscodes.COMP_JLT_CODE:
+        return a not in REGISTERS or b not in REGISTERS
+    if opcode == basscodes.COMP_IMM_CODE:
+        return a not in REGISTERS
+    return opcode not in (basscodes.COMP_SYS_CODE, basscodes.COMP_JMP_CODE, basscodes.COMP_JNE_CODE)
+
+
+def reachable(ins):
+    # Slots the program can get to from 0, and the ones something jumps to
+    seen = set()
+    targets = set()
+    todo = [0]
+    while todo:
+        i = todo.pop()
+        if i in seen:
+            continue
+        seen.add(i)
+        opcode, a, b = ins[i]
+        if is_bad(opcode, a, b):
+            continue
+        if opcode in (basscodes.COMP_JMP_CODE, basscodes.COMP_JNE_CODE):
+            targets.add(a)
+            todo.append(a)
+        if opcode == basscodes.COMP_JLT_CODE:
+            targets.add(i)
+        if opcode not in TERMINAL:
+            # ip is 8 bits, slot 255 runs into slot 0
+            nxt = (i + 1) % SLOTS
+            if nxt != i + 1:
+                targets.add(nxt)
+            todo.append(nxt)
+    return sorted(seen), targets
+
+
+def translate_slot(i, ins):
+    opcode, a, b = ins
+    if is_bad(opcode, a, b):
+        if opcode in REG_OPS or opcode in (basscodes.COMP_JLT_CODE, basscodes.COMP_IMM_CODE):
+            return ["computer_badreg(state, 0, 0);", "goto done;"]
+        return ["computer_badins(state, 0, 0);", "goto done;"]
+
+    ra, rb = REGISTERS.get(a), REGISTERS.get(b)
+    if opcode in REG_OPS:
+        return [REG_OPS[opcode].format(a=ra, b=rb)]
+    if opcode == basscodes.COMP_IMM_CODE:
+        return [f"{ra} = 0x{b:02x};"]
+    if opcode == basscodes.COMP_SYS_CODE:
+        # computer_sys only uses ra and rb, and moves ip past the SYS
+        return ["state->r[COMP_RA] = ra;",
+                "state->r[COMP_RB] = rb;",
+                f"state->ip = {i};",
+                f"if (computer_sys(state, 0x{a:02x}, 0x{b:02x})) {{",
+                "\tra = state->r[COMP_RA];",
+                "\tgoto done;",
+                "}",
+                "ra = state->r[COMP_RA];"]
+    if opcode == basscodes.COMP_JMP_CODE:
+        return [f"goto ins_{a};"]
+    if opcode == basscodes.COMP_JNE_CODE:
+        return ["if ((fl >> COMP_FLAG_ZERO_SHIFT) & 1) {",
+                f"\tgoto ins_{a};",
+                "}"]
+    if opcode == basscodes.COMP_JLT_CODE:
+        # The interpreter runs JLT as an ADD that does not move ip
+        return [f"{ra} += {rb};", f"goto ins_{i};"]
+    raise ValueError(f"no translation for opcode {opcode:#x}")
+
+
+def translate(program, name):
+    ins = slots(program)
+    order, targets = reachable(ins)
+
+    # Slots fall through to the next one unless they jumped or ended, which
+    # needs a goto when that slot is not emitted right after
+    fall = {}
+    for pos, i in enumerate(order):
+        following = order[pos + 1] if pos + 1 < len(order) else None
+        nxt = (i + 1) % SLOTS
+        if not is_bad(*ins[i]) and ins[i][0] not in TERMINAL and nxt != following:
+            fall[i] = nxt
+            targets.add(nxt)
+
+    body = []
+    for i in order:
+        if i in targets:
+            body.append(f"ins_{i}:")
+        body += ["\t" + line for line in translate_slot(i, ins[i])]
+        if i in fall:
+            body.append(f"\tgoto ins_{fall[i]};")
+    return render(name, body)
+
+
+def render(name, body):
+    # Programs that loop forever never get to done
+    done = """
+done:
+	state->fl = fl;
+	state->r[COMP_RA] = ra;
+	state->r[COMP_RB] = rb;
+	state->r[COMP_RC] = rc;
+	state->r[COMP_RD] = rd;
+	state->r[COMP_RE] = re;
+	state->r[COMP_RF] = rf;
+	return ra;
+""" if any(line.strip() == "goto done;" for line in body) else "\treturn 0;\n"
+
+    return f"""// Generated by tools/basspiler.py from {name}, do not edit
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bass.h"
+#include "computer.h"
+
+uint8_t bass_native(computer_state *state) {{
+	uint8_t fl = state->fl;
+	uint8_t ra = state->r[COMP_RA];
+	uint8_t rb = state->r[COMP_RB];
+	uint8_t rc = state->r[COMP_RC];
+	uint8_t rd = state->r[COMP_RD];
+	uint8_t re = state->r[COMP_RE];
+	uint8_t rf = state->r[COMP_RF];
+
+""" + "\n".join(body) + "\n" + done + "}\n"
+
+
+if __name__ == "__main__":
+    if (len(sys.argv) < 3):
+        print(f"Usage: {sys.argv[0]} <infile> <outfile>")
+        exit()
+
+    with open(sys.argv[1], 'r') as f:
+        program = assemble(f.readlines(), log=lambda *args: None)
+
+    with open(sys.argv[2], 'w') as f:
+        f.write(translate(program, sys.argv[1].split('/')[-1]))
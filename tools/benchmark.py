@@ -0,0 +1,248 @@
+#!/usr/bin/env python3
+
+"""
+Update Benchmark
+
+Runs fw_protect.py, fw_update.py and a boot against the host simulator
+(make host in the bootloader directory) for a range of firmware sizes and
+reports:
+
+- update throughput in firmware bytes/s
+- per-frame latency percentiles, from writing a frame to reading its OK
+- time the bootloader spent in CRC, flash, crypto, key/firmware obfuscation
+  (bf_decrypt and bass_crypt) and UART calls during the update
+- boot-to-jump latency, from sending 'B' to the bootloader jumping to the firmware
+
+Every size starts from freshly flashed simulator files. The pty has no line
+rate, so the link column estimates how long the same bytes take on a real
+UART at --line-baud.
+"""
+
+import argparse
+import contextlib
+import io
+import json
+import os
+import pathlib
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+from collections import deque
+
+import serial
+
+import fw_protect
+import fw_update
+
+REPO_ROOT = pathlib.Path(__file__).parent.parent.absolute()
+TOOL_DIR = pathlib.Path(__file__).parent.absolute()
+BOOTLOADER_DIR = os.path.join(REPO_ROOT, "bootloader")
+DEFAULT_SIM = os.path.join(BOOTLOADER_DIR, "sim/bin/bootloader_sim")
+DEFAULT_IMAGE = os.path.join(BOOTLOADER_DIR, "bin/bootloader.bin")
+DEFAULT_SECRETS = os.path.join(TOOL_DIR, "secret_build_output.txt")
+
+FRAME_SIZE = 1024
+# STORAGE_PART_SIZE blocks minus the metadata, message and signature blocks,
+# and the padding always adds at least one byte
+STORAGE_PART_SIZE = 78
+MAX_FIRMWARE_SIZE = (STORAGE_PART_SIZE - 3) * FRAME_SIZE - 1
+# firmware is decrypted into SRAM, bigger images can't be booted
+SRAM_SIZE = 0x8000
+DEFAULT_SIZES = [1024, 2048, 4096, 8192, 16384, 32768, 65536, MAX_FIRMWARE_SIZE]
+
+CATEGORIES = ["crc", "flash", "crypto", "vm", "uart"]
+# simulator start up, update and boot should all finish well within this
+TIMEOUT = 30
+
+
+class TimedLink(fw_update.Link):
+    """fw_update.py's link, timestamping every frame it sends and the OK it gets back"""
+
+    def __init__(self, ser, proc):
+        super().__init__(ser)
+        self.proc = proc
+        self.sent = deque()
+        self.latencies = []
+        self.bytes_written = 0
+
+    def send(self, data):
+        # fw_update.py writes every frame in one piece
+        if data[:1] == fw_update.SEND_FRAME:
+            self.sent.append(time.perf_counter())
+        self.bytes_written += len(data)
+        super().send(data)
+
+    def expect(self, response, timeout=None):
+        try:
+            super().expect(response, timeout)
+        except fw_update.LinkTimeout:
+            raise RuntimeError(f"bootloader stopped responding (simulator exit code {self.proc.poll()})")
+        if response == fw_update.RESP_OK and self.sent:
+            self.latencies.append(time.perf_counter() - self.sent.popleft())
+
+
+def read_stats(path, count):
+    # Waits for the simulator to write count lines and returns the last one as a dict
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        if os.path.exists(path):
+            with open(path) as f:
+                lines = f.read().splitlines()
+            if len(lines) >= count:
+                return {k: v if k == "event" else int(v) for k, v in (kv.split("=") for kv in lines[count - 1].split())}
+        time.sleep(0.01)
+    raise RuntimeError("simulator did not write its stats")
+
+
+def percentile(values, p):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+def run_one(args, size, workdir):
+    firmware = os.urandom(size)
+    fw_file = os.path.join(workdir, "firmware.bin")
+    protected_file = os.path.join(workdir, "firmware_protected.bin")
+    uart_link = os.path.join(workdir, "uart")
+    stats_file = os.path.join(workdir, "stats.txt")
+    ram_file = os.path.join(workdir, "sram.bin")
+
+    with open(fw_file, "wb") as f:
+        f.write(firmware)
+    with contextlib.redirect_stdout(io.StringIO()):
+        fw_protect.protect_firmware(fw_file, protected_file, 2, "benchmark", args.secrets)
+
+    with open(os.path.join(workdir, "sim.log"), "w") as log:
+        proc = subprocess.Popen([args.sim,
+                                 "--flash", os.path.join(workdir, "flash.bin"),
+                                 "--eeprom", os.path.join(workdir, "eeprom.bin"),
+                                 "--image", args.image,
+                                 "--uart", uart_link,
+                                 "--stats", stats_file,
+                                 "--fw-out", ram_file,
+                                 "--exit-on-boot"], stdout=log, stderr=log)
+    try:
+        deadline = time.time() + TIMEOUT
+        while not os.path.exists(uart_link):
+            if proc.poll() is not None or time.time() > deadline:
+                raise RuntimeError("simulator did not start, see sim.log")
+            time.sleep(0.01)
+
+        # The first boot moves the secrets to EEPROM and resets, then the bootloader
+        # greets and waits for an instruction. Drop the greeting, it contains a 'U'
+        provisioned = read_stats(stats_file, 1)
+        ser = serial.Serial(uart_link, fw_update.DEFAULT_BAUD, timeout=TIMEOUT)
+        time.sleep(0.2)
+        ser.reset_input_buffer()
+        link = TimedLink(ser, proc)
+
+        # A retry would hide the failure and skew the timings
+        idle_ns = time.monotonic_ns() - provisioned["t"]
+        start = time.perf_counter()
+        with contextlib.redirect_stdout(io.StringIO()):
+            fw_update.update(link=link, infile=protected_file,
+                             window=args.window, baud=fw_update.DEFAULT_BAUD, retries=0)
+        update_time = time.perf_counter() - start
+
+        # The bootloader resets once the update is stored
+        update_stats = read_stats(stats_file, 2)
+
+        result = {
+            "size": size,
+            "update_s": update_time,
+            "bytes_per_s": size / update_time,
+            "link_s": link.bytes_written * 10 / args.line_baud,
+            "frame_ms": [t * 1000 for t in link.latencies],
+        }
+        for c in CATEGORIES:
+            result[c + "_ms"] = update_stats[c + "_ns"] / 1e6
+        # The bootloader was blocked in a UART read while we waited to start the update
+        result["uart_ms"] = max(0, update_stats["uart_ns"] - idle_ns) / 1e6
+
+        if size <= SRAM_SIZE:
+            start = time.monotonic_ns()
+            ser.write(b"B")
+            boot_stats = read_stats(stats_file, 3)
+            if boot_stats["event"] != "jump":
+                raise RuntimeError("bootloader reset instead of booting, see sim.log")
+            proc.wait(TIMEOUT)
+            result["boot_ms"] = (boot_stats["t"] - start) / 1e6
+            result["boot_crypto_ms"] = boot_stats["crypto_ns"] / 1e6
+            result["boot_vm_ms"] = boot_stats["vm_ns"] / 1e6
+            with open(ram_file, "rb") as f:
+                result["boot_ok"] = f.read(size) == firmware
+        ser.close()
+    finally:
+        if proc.poll() is None:
+            proc.kill()
+        proc.wait()
+    return result
+
+
+def summarize(size, runs):
+    # Medians over the runs, latency percentiles over every frame of every run
+    summary = {"size": size, "runs": len(runs)}
+    for key in runs[0]:
+        if key in ("size", "frame_ms", "boot_ok"):
+            continue
+        summary[key] = statistics.median(r[key] for r in runs)
+    frames = [t for r in runs for t in r["frame_ms"]]
+    for p in (50, 90, 99):
+        summary[f"frame_p{p}_ms"] = percentile(frames, p)
+    if "boot_ok" in runs[0]:
+        summary["boot_ok"] = all(r["boot_ok"] for r in runs)
+    return summary
+
+
+def print_summary(s):
+    if "boot_ms" in s:
+        boot = f"{s['boot_ms']:8.2f} {s['boot_crypto_ms']:8.2f} {s['boot_vm_ms']:8.2f} {'ok' if s['boot_ok'] else 'BAD'}"
+    else:
+        boot = f"{'-':>8} {'-':>8} {'-':>8} -"
+    print(f"{s['size']:7} {s['update_s']:8.3f} {s['bytes_per_s']:9.0f} {s['link_s']:7.3f} "
+          f"{s['frame_p50_ms']:6.2f} {s['frame_p90_ms']:6.2f} {s['frame_p99_ms']:6.2f} "
+          + " ".join(f"{s[c + '_ms']:8.2f}" for c in CATEGORIES) + " " + boot)
+
+
+def benchmark(args):
+    for path in (args.sim, args.image, args.secrets):
+        if not os.path.exists(path):
+            sys.exit(f"{path} is missing, run bl_build.py and make host in the bootloader directory first")
+
+    print(f"window {args.window}, {args.runs} run(s) per size, link estimated at {args.line_baud} baud, times in ms unless noted")
+    print(f"firmware over {SRAM_SIZE} bytes does not fit in SRAM and is not booted")
+    print(f"{'size':>7} {'update s':>8} {'bytes/s':>9} {'link s':>7} {'p50':>6} {'p90':>6} {'p99':>6} "
+          + " ".join(f"{c:>8}" for c in CATEGORIES) + f" {'boot':>8} {'bcrypto':>8} {'bvm':>8} fw")
+
+    results = []
+    for size in args.sizes:
+        runs = []
+        for _ in range(args.runs):
+            with tempfile.TemporaryDirectory() as workdir:
+                runs.append(run_one(args, size, workdir))
+        summary = summarize(size, runs)
+        print_summary(summary)
+        results.append(summary)
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+    if not all(r.get("boot_ok", True) for r in results):
+        sys.exit("firmware in SRAM does not match what was protected")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Update Benchmark")
+    parser.add_argument("--sim", help="Path to the simulator.", default=DEFAULT_SIM)
+    parser.add_argument("--image", help="Bootloader image with the secrets block.", default=DEFAULT_IMAGE)
+    parser.add_argument("--secrets", help="File containing secrets.", default=DEFAULT_SECRETS)
+    parser.add_argument("--sizes", help="Firmware sizes in bytes.", type=int, nargs="+", default=DEFAULT_SIZES)
+    parser.add_argument("--runs", help="Runs per size.", type=int, default=3)
+    parser.add_argument("--window", help="Firmware frames to keep in flight.", type=int, default=fw_update.WINDOW_SIZE)
+    parser.add_argument("--line-baud", help="Baud rate used for the link estimate.", type=int, default=fw_update.BAUD_RATE)
+    parser.add_argument("--json", help="Also write the results to this file.")
+    args = parser.parse_args()
+
+    benchmark(args)
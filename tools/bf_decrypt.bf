@@ -0,0 +1,35 @@
+[>]>[->]>>>>>>>+++++++++++++++++++++++++++++++++++++++++++++++++
+++++>+++++++0[[>]<[>+<-]0]++++++[[[>]<[>+<-]0]>[<+>-]+<-]0>>>>>>
+[-<]>>>>++++>++++>>>[<<+>>-]0>>>>>^[0>>>>^+0>>>>>^-]0>>>>+>++0>>
+>>>^[0>[>^[>+<-]0>>-<-]0>>>>>^[0>>>>^+0>>>>>^-]v0>>[-]>+>+>++[0+
+>>+>>>-]0[>>>>>+0-]>>>[0+>+>>-]0[>>>+0-]>>>>>^]0>[>^[>+<-]0>>-<-
+]0>>>>>>[0>>^>+0>>>>>>-]0>>>[-]>[-]>[-]0>>^[>]>>[>]<[0>>>>+>>>[>
+]>>[>]<-]0>>^[>]>>[>]<[0>>>+>>>>[>]>>[>]<-]0>>^>[[>]<[>+<-]0>>^>
+]0>>>>>^>>[0>>>>>[>+0+>>>>>-]0[>>>>>+>+0-]>>>[0+>+>>-]0>[>>+<<-]
+0[>>>>>^>>-0-]>>>>>>[<^>>-0>>>>>>-]<+^>>]0>++++++++++++++++++++[
+>>>>>>[>]>[>]<[[>+<-]<]0>>>>>>>[>]<[[>+<-]<]>+0>-]>>>>>>[>]>>[[>
+]<[[>+<-]<]0>>>>>>>[>]>>]0>>>>>>>>>>>>>>>>>>>>>>>>>>[-<]<<[>>>>>
+>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<-]>[-]<<[-]<[-]>>>>>>>>>>>
+>>>>>>>>>>>>>>[>]>^>>[0>>>>>>>>>>>>>>>>>>>>>>>>>>>[>]>[0+>>>>>>>
+>>>>>>>>>>>>>>>>>>>>[>]>-]0[>>>>>>>>>>>>>>>>>>>>>>>>>>>[>]>+>++0
+-]>>>>>>>>>>>>>>>>>>>>>>>>>[0+>>>>>>>>>>>>>>>>>>>>>>>>>-]0[>+>>>
+>>>>>>>>>>>>>>>>>>>>>+0-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[>]>>[0
+>+>>>>>>>>>>>>>>>>>>>>>>>>>>[>]>>-]0>+>>>>>>>++++++++++++++++0>[
+[>>>>>+<<<<<<+>-]<[>+<-]>>>>+>>[-[-<]>]<<[->]0>>>>[>>>>^+0>>>>-]
+>>>>-0>[[>>>>>+0+>-]0[>+<-]>>>>+>>[-[-<]>]<<[->]0>>>>[0>>>+<->>-
+]0>>+<-]>[<+>-]>[-]<<]v0>>>>>>>>[-]++++++++>>>>>>>>>>>>>>>>>>>[>
+]>^>>[0>+>>>>>>>>>>>>>>>>>>>>>>>>>>[>]>^>>-]0>-[[>>>>>+<<<<<<+>-
+]<[>+<-]>>>>+>>[-[-<]>]<<[->]0>>>>[>>>>^+0>>>>-]>>>>-0>[[>>>>>+0
++>-]0[>+<-]>>>>+>>[-[-<]>]<<[->]0>>>>[0>>>+<->>-]0>>+<-]>[<+>-]>
+[-]<<]0>>>>>>>++++++++>[-]+<[>^[0>+>>>>>>>^-]0>>>>>>>>^>>>>>>>>[
+0>+>>>>>>>^>>>>>>>>-]0>-[>-<<]0>>+<[-]>[>>>>>>^+0>>-]>>>>>>+<-]+
++++++++>[-]+<[>^[0>>>>>>>[<<+<<+>>>>-]<<<<[>>>>+<<<<-]>+>-[<[<++
+>-]<[>+<-]>>-]<[>>+<<-]0]0>>>>>>>->+<]0>>>>>>[>>>>>>>>>>>>>>>>>>
+>>>[>]>^>>+0>>>>>>-]0>>>>>>>>>>>>>>>>[-]<[-]<[-]<[-]<[-]<[-]<[-]
+<[-]<[-]>>>>>>>>>>>>>>>>>>>[>]>+^>>]0>>>>>>>>>>>>>>>>>>>>>>>>>[-
+]>>[>]>[-]>>[[<+>-]>]<<[<]>[[<+>-]>]0+++++++++++++++++++++++++[^
+>>[[<+>-]>]>[[<+>-]>]0-]^>>[0+^>>]0^>>^>[0^>>+^>]0^>>[0>+<^>>-]0
+>[<->-]>[>]>[>]<[>>+<<-]0[>>[>]>[>]>>[<+>-]0>>[>]<[>>[>]>>+0>>[>
+]<-]0>>[>]>>[[<+>-]>]0-]>>>[[>]<[>>[>]>+<<[<]<-]>>[>]<[>+<-]<[<]
+>[[<+>-]>]0>>>]>>>[[<+>-]>]0>>>>>[[<+>-]>]0>>>>[[<+>-]>]0>>[[<+>
+-]>]0>[[<+>-]>]
@@ -0,0 +1,231 @@
+#!/usr/bin/env python
+
+"""
+BF Key Program Compiler
+
+Compiles the program bf_decrypt runs over the keys into the instruction table
+in bootloader/src/bf_program.c, so the bootloader never looks at the source
+characters. Besides the usual > < + - [ ] the program uses
+    0  pointer back to the first cell
+    ^  pointer forward by the value of the current cell
+    v  pointer back by the value of the current cell
+with > wrapping from the last cell to the first and < stopping at the first.
+
+Runs of the same move and of +/- become one instruction, 0 takes the moves
+after it along, and every bracket knows where its partner is. Loops that only
+clear a cell ([-]), look for a zero ([>], [<<]) or add the counter to other
+cells ([>+<-], also the ones that go through 0) get an instruction of their
+own. A move is checked when it runs and falls back to the loop after it when
+the pointer is not where the compiler could prove it right.
+
+Usage: bfcompiler.py <infile> <outfile>
+e.g. python bfcompiler.py bf_decrypt.bf ../bootloader/src/bf_program.c
+"""
+
+import sys
+
+TAPE_SIZE = 50
+MAX_RUN = 255
+COMMANDS = "><+-0^v[]"
+
+
+def parse(source):
+    # Nested lists for loops, single characters for everything else
+    stack = [[]]
+    for c in source:
+        if c not in COMMANDS:
+            continue
+        if c == '[':
+            stack.append([])
+        elif c == ']':
+            if len(stack) == 1:
+                raise ValueError("unmatched ]")
+            loop = stack.pop()
+            stack[-1].append(loop)
+        else:
+            stack[-1].append(c)
+    if len(stack) != 1:
+        raise ValueError("unmatched [")
+    return stack[0]
+
+
+def runs(body):
+    # (command, count) with runs of >, < and +/- folded, + counting up and - down
+    out = []
+    for node in body:
+        if isinstance(node, list):
+            out.append(("[", node))
+            continue
+        kind = "+" if node in "+-" else node
+        step = -1 if node == "-" else 1
+        if out and out[-1][0] == kind and kind in "><+":
+            out[-1] = (kind, out[-1][1] + step)
+        else:
+            out.append((kind, step))
+    return out
+
+
+def step_right(pos, n):
+    # > from a cell on the tape, n times
+    return (pos + n) % TAPE_SIZE
+
+
+def step_left(pos, n):
+    return max(pos - n, 0)
+
+
+def move_targets(body):
+    """
+    For a loop body of only > < + - 0 that brings the pointer back to the
+    counter and takes one off it (or adds one), returns (at, targets) where
+    targets are (offset from the counter, amount added per unit of the counter)
+    and at is the cell the counter has to be in, or None when any cell works
+    as long as every cell the body walks over is on the tape
+    """
+    ops = runs(body)
+    if any(kind not in "><+0" for kind, _ in ops):
+        return None
+
+    at = None
+    if any(kind == "0" for kind, _ in ops):
+        # Where the body ends is known, and the second time round it starts
+        # there, so only a counter in that cell can be folded
+        at = 0
+        for kind, n in ops[[kind for kind, _ in ops].index("0"):]:
+            if kind == ">":
+                at = step_right(at, n)
+            elif kind == "<":
+                at = step_left(at, n)
+            elif kind == "0":
+                at = 0
+
+    pos = 0 if at is None else at
+    low = high = pos
+    added = {}
+    for kind, n in ops:
+        if kind == "+":
+            added[pos] = (added.get(pos, 0) + n) % 256
+        elif at is None:
+            # Relative, the pointer never leaves the tape because of the checks
+            pos += n if kind == ">" else -n
+        elif kind == ">":
+            pos = step_right(pos, n)
+        elif kind == "<":
+            pos = step_left(pos, n)
+        else:
+            pos = 0
+        low, high = min(low, pos), max(high, pos)
+
+    start = 0 if at is None else at
+    if pos != start or added.get(start, 0) not in (1, 255):
+        return None
+
+    # Counted up the loop runs 256 - counter times, the same as counting down
+    # with every amount negated
+    sign = -1 if added[start] == 255 else 1
+    targets = [(p - start, (-sign * a) % 256) for p, a in sorted(added.items()) if p != start and a]
+    if at is None:
+        # Amount 0 entries only make the walk's ends get checked
+        for p in (low, high):
+            if p != start and all(p - start != off for off, _ in targets):
+                targets.append((p - start, 0))
+    return at, targets
+
+
+def single(body):
+    ops = runs(body)
+    return ops[0] if len(ops) == 1 else (None, 0)
+
+
+def emit(body, out):
+    ops = runs(body)
+    i = 0
+    while i < len(ops):
+        kind, n = ops[i]
+        i += 1
+        if kind in "><":
+            while n > 0:
+                out.append(["BF_RIGHT" if kind == ">" else "BF_LEFT", min(n, MAX_RUN), 0])
+                n -= MAX_RUN
+        elif kind == "+":
+            if n % 256:
+                out.append(["BF_ADD", n % 256, 0])
+        elif kind == "0":
+            # The moves right after 0 land on a known cell
+            moves = 0
+            if i < len(ops) and ops[i][0] == ">":
+                moves = ops[i][1]
+                i += 1
+            out.append(["BF_SET", moves % TAPE_SIZE, 0])
+        elif kind == "^":
+            out.append(["BF_UP", 0, 0])
+        elif kind == "v":
+            out.append(["BF_DOWN", 0, 0])
+        else:
+            emit_loop(n, out)
+
+
+def emit_loop(body, out):
+    only, n = single(body)
+    if only == "+" and n % 2:
+        # Any odd step gets to zero
+        out.append(["BF_CLEAR", 0, 0])
+        return
+    if only is not None and only in "><" and n <= MAX_RUN:
+        out.append(["BF_SCAN_RIGHT" if only == ">" else "BF_SCAN_LEFT", n, 0])
+        return
+
+    back = None
+    move = move_targets(body)
+    if move is not None:
+        at, targets = move
+        back = len(out)
+        if at is None:
+            out.append(["BF_MOVE", len(targets), 0])
+        else:
+            out.append(["BF_MOVE_AT", len(targets), at])
+        for offset, amount in targets:
+            out.append(["BF_TARGET", amount, offset])
+
+    # [ skips past its ], ] goes back to after its [ or to the move in front
+    open_at = len(out)
+    out.append(["BF_OPEN", 0, 0])
+    emit(body, out)
+    out.append(["BF_CLOSE", 0, open_at + 1 if back is None else back])
+    out[open_at][2] = len(out)
+
+
+def compile_program(source):
+    out = []
+    emit(parse(source), out)
+    out.append(["BF_END", 0, 0])
+    if len(out) > 0x7FFF:
+        raise ValueError("program too long for 16 bit jumps")
+    return out
+
+
+def render(name, program):
+    lines = [f"\t{{{op}, {a}, {b}}}," for op, a, b in program]
+    return f"""// Generated by tools/bfcompiler.py from {name}, do not edit
+
+#include <stdint.h>
+#include <bf.h>
+
+#if TAPE_SIZE != {TAPE_SIZE}
+#error "bf_program.c was compiled for a different tape size"
+#endif
+
+const bf_instruction bf_program[] = {{
+""" + "\n".join(lines) + "\n};\n"
+
+
+if __name__ == "__main__":
+    if (len(sys.argv) < 3):
+        print(f"Usage: {sys.argv[0]} <infile> <outfile>")
+        exit()
+
+    with open(sys.argv[1], 'r') as f:
+        program = compile_program(f.read())
+
+    with open(sys.argv[2], 'w') as f:
+        f.write(render(sys.argv[1].split('/')[-1], program))
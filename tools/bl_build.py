@@ -11,6 +11,7 @@ import pathlib
 import subprocess
 from Crypto.PublicKey import ECC
 from encrypt_util import bf_encrypt
+import ssb
 
 #change this once we decide on algorithm
 KEY_SIZE=16
@@ -22,6 +23,10 @@ BOOTLOADER_DIR = os.path.join(REPO_ROOT, "bootloader")
 SECRETS_FILE=os.path.join(TOOL_DIR, "secret_build_output.txt")
 PUBLIC_FILE=os.path.join(BOOTLOADER_DIR, "inc/public.h")
 
+def bad_key(key, key_bf):
+    # The EEPROM copy can't have zeros, and with libssb built check the board decodes it back
+    return b'\x00' in key_bf or (ssb.NATIVE and ssb.bf_decrypt(key_bf) != key)
+
 def generate_keys():
     print("making funny keys")
     decrypt_key=os.urandom(KEY_SIZE)
@@ -30,7 +35,7 @@ def generate_keys():
     decrypt_bf = bf_encrypt(decrypt_key)
     hmac_key_bf = bf_encrypt(hmac_key)
 
-    while ((b'\x00' in decrypt_bf) or (b'\x00' in hmac_key_bf)):
+    while bad_key(decrypt_key, decrypt_bf) or bad_key(hmac_key, hmac_key_bf):
         decrypt_key=os.urandom(KEY_SIZE)
         hmac_key=os.urandom(KEY_SIZE)
 
@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+
+"""
+Bootloader Profile Reader
+
+Reads the cycle counts of a bootloader built with `make PROFILE=1`.
+Without --boot the table is requested with the 'P' command, it holds every
+region since power on, including the last update. With --boot the firmware
+is booted and the table the bootloader prints before jumping is read instead.
+
+--save writes the table to a JSON file and --baseline compares against one,
+for example a default build against one made with FAST_CRYPTO=1.
+"""
+
+import argparse
+import json
+import serial
+
+SEND_PROFILE = b"P"
+SEND_BOOT = b"B"
+
+
+def read_regions(ser, regions):
+    # Region lines up to the next empty line, anything else the bootloader prints is skipped
+    line = ser.readline()
+    while line.strip():
+        fields = line.decode(errors="replace").split()
+        if len(fields) == 6:
+            name = fields[0]
+            count, low, high, total_hi, total_lo = (int(f, 16) for f in fields[1:])
+            total = (total_hi << 32) | total_lo
+            # A region can be listed more than once, merge the lines
+            if name in regions:
+                c, l, h, t = regions[name]
+                count, low, high, total = c + count, min(l, low), max(h, high), t + total
+            regions[name] = (count, low, high, total)
+        line = ser.readline()
+    if line == b"":
+        raise RuntimeError("ERROR: Bootloader stopped in the middle of the profile")
+
+
+def read_table(ser, boot=False):
+    # Skip anything before the table header
+    line = ser.readline()
+    while not line.startswith(b"P "):
+        if line == b"":
+            raise RuntimeError("ERROR: Bootloader did not send a profile")
+        line = ser.readline()
+    hz = int(line.split()[1], 16)
+
+    regions = {}
+    read_regions(ser, regions)
+    # Booting prints copy_fw_to_ram and bass_crypt after the Dumb Bass program
+    if boot and hz:
+        read_regions(ser, regions)
+    return hz, regions
+
+
+def save_table(path, hz, regions):
+    with open(path, "w") as f:
+        json.dump({"hz": hz, "regions": regions}, f, indent=1)
+
+
+def load_table(path):
+    with open(path) as f:
+        table = json.load(f)
+    return table["hz"], {name: tuple(r) for name, r in table["regions"].items()}
+
+
+def print_table(hz, regions, baseline=None):
+    if hz == 0:
+        print("Profiling is not compiled in, rebuild the bootloader with make PROFILE=1")
+        return
+
+    us = 1e6 / hz
+    header = f"{'region':24} {'count':>7} {'min us':>10} {'avg us':>10} {'max us':>10} {'total us':>12}"
+    if baseline:
+        header += f" {'base avg':>10} {'speedup':>8}"
+    print(header)
+    for name, (count, low, high, total) in sorted(regions.items(), key=lambda r: -r[1][3]):
+        line = f"{name:24} {count:7} {low * us:10.1f} {total / count * us:10.1f} {high * us:10.1f} {total * us:12.1f}"
+        if baseline and name in baseline[1]:
+            base_hz, (base_count, _, _, base_total) = baseline[0], baseline[1][name]
+            base_avg = base_total / base_count * 1e6 / base_hz
+            line += f" {base_avg:10.1f} {base_avg / (total / count * us):7.2f}x"
+        print(line)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Bootloader Profile Reader")
+    parser.add_argument("--port", help="Serial port of the bootloader.", default="/dev/ttyACM0")
+    parser.add_argument("--boot", help="Boot the firmware and read the boot profile.", action="store_true")
+    parser.add_argument("--save", help="Write the table to a JSON file.")
+    parser.add_argument("--baseline", help="Compare against a table written with --save.")
+    args = parser.parse_args()
+
+    ser = serial.Serial(args.port, 115200, timeout=5)
+    ser.write(SEND_BOOT if args.boot else SEND_PROFILE)
+    hz, regions = read_table(ser, args.boot)
+    ser.close()
+
+    if args.save:
+        save_table(args.save, hz, regions)
+    print_table(hz, regions, load_table(args.baseline) if args.baseline else None)
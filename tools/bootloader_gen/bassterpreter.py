@@ -169,11 +169,39 @@ class State:
                 self.readp += 1
                 self.readr -= 1
             
+            case basscodes.COMP_SYS_WRITE_BLOCK:
+                if (self.writer == 0):
+                    self.ra = 33
+                    print("no write")
+                    return True
+                count = min(self.rb, self.writer)
+                for i in range(count):
+                    self.writeb.append(self.memory[(a + i) & 0xFF])
+                self.writer -= count
+                self.ra = count
+
+            case basscodes.COMP_SYS_READ_BLOCK:
+                if (self.readr == 0):
+                    self.ra = 44
+                    print("no read")
+                    return True
+                count = min(self.rb, self.readr)
+                for i in range(count):
+                    self.memory[(a + i) & 0xFF] = self.readb[self.readp + i]
+                self.readp += count
+                self.readr -= count
+                self.ra = count
+
+            case basscodes.COMP_SYS_XOR_BLOCK:
+                for i in range(self.rb):
+                    self.memory[(a + i) & 0xFF] ^= self.memory[(b + i) & 0xFF]
+                self.ra = self.rb
+
             case basscodes.COMP_SYS_EXIT:
                 return True
 
             case _:
-                state.ra = 55
+                self.ra = 55
                 return True
 
     def jmp(self, a, b):
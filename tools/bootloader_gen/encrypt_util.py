@@ -1,19 +1,10 @@
-import bassterpreter
+import os
+import sys
 
-def bf_encrypt(plaintext):
-    
-    with open('special.sdo', 'rb') as f:
-        data = f.read()
-
-    w = []
-    thing = bassterpreter.State(data, w, plaintext, len(plaintext), len(plaintext))
-
-    end = False
-    while (not end):
-        end = thing.interpret_instruction()
-
-    r = b''
-    for c in w:
-        r += int.to_bytes(c)
-    return r
+# ssb.py is in tools/, next to this file or one up from bootloader_gen/
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+import ssb
 
+def bf_encrypt(plaintext):
+    # libssb's version of special.sdo, which bassterpreter.py still runs the same
+    return ssb.bf_encrypt(plaintext)
@@ -3,11 +3,22 @@
 """
 Firmware Bundle-and-Protect Tool
 
+The firmware is read, XORed, encrypted and written CHUNK_SIZE bytes at a time,
+so memory use does not grow with the image. The signature goes in front of the
+encrypted data, so its space is written first and filled in at the end, after
+a second pass over what was written (see StreamSigner).
+
+With --manifest many versions and messages are packaged from one image, see
+protect_batch.
 """
 import argparse
+import json
 import os
+import tempfile
+from concurrent.futures import ProcessPoolExecutor
+from itertools import repeat
 from pwn import *
-from Crypto.Hash import HMAC, SHA256
+from Crypto.Hash import HMAC, SHA256, SHA512
 from Crypto.Util.Padding import pad, unpad
 from Crypto.Cipher import AES
 from Crypto.PublicKey import ECC
@@ -16,79 +27,195 @@ from Crypto.Util.asn1 import DerSequence, DerInteger
 
 import struct
 
-DEFAULT_SECRETS="./secret_build_output.txt"
+import ssb
 
+DEFAULT_SECRETS="./secret_build_output.txt"
 
-def protect_firmware(infile, outfile, version, message, secrets):
-    # Load firmware binary from infile
+# Bytes of firmware per step, a multiple of the BASS key and the AES block so every chunk starts in phase
+CHUNK_SIZE = 16384
+
+SIGNATURE_SIZE = ssb.SIZES["SIGNATURE"]
+
+# Ed25519 base point and group order (RFC 8032)
+ED25519_BASE = (0x216936d3cd6e53fec0a4e231fdd6dc5c692cc7609525a7b2c9562d608f25d51a,
+                0x6666666666666666666666666666666666666666666666666666666666666658)
+ED25519_ORDER = 2**252 + 0x14def9dea2f79cd65812631a5cf5d3ed
+
+
+class StreamSigner:
+    """
+    Ed25519 (RFC 8032, the same signature eddsa.new(key, 'rfc8032') makes) over
+    a message fed in chunks. The nonce is a hash of the whole message and the
+    signature hashes the message again after the nonce, so the message goes
+    through update once and is read again by sign.
+    """
+
+    def __init__(self, key):
+        h = SHA512.new(key.seed).digest()
+        a = bytearray(h[:32])
+        a[0] &= 248
+        a[31] = (a[31] & 127) | 64
+        self.a = int.from_bytes(a, 'little')
+        self.public = key.public_key().export_key(format='raw')
+        self.nonce = SHA512.new(h[32:])
+
+    def update(self, data):
+        self.nonce.update(data)
+
+    def sign(self, chunks):
+        r = int.from_bytes(self.nonce.digest(), 'little') % ED25519_ORDER
+        base = ECC.EccPoint(*ED25519_BASE, curve='Ed25519')
+        R = ECC.EccKey(curve='Ed25519', point=base * r).export_key(format='raw')
+
+        h = SHA512.new(R + self.public)
+        for chunk in chunks:
+            h.update(chunk)
+        k = int.from_bytes(h.digest(), 'little') % ED25519_ORDER
+        s = (r + k * self.a) % ED25519_ORDER
+        return R + s.to_bytes(32, 'little')
+
+
+def read_chunks(fp, length):
+    # length bytes from the current position of fp, CHUNK_SIZE at a time
+    while length > 0:
+        chunk = fp.read(min(CHUNK_SIZE, length))
+        if not chunk:
+            raise EOFError("file ended early")
+        length -= len(chunk)
+        yield chunk
+
+
+def load_secrets(secrets):
     if secrets is None:
         secrets = DEFAULT_SECRETS
-    with open(infile, "rb") as fp:
-        firmware = fp.read()
-
-        # Do stupid stuff before encryption here!
-        firmware = basscrypt(firmware)
-
-    firmware_padded = pad(firmware, 16)
-
     with open(secrets, 'r') as f:
         encrypt_key = bytes.fromhex(f.readline())
         hmac_key = bytes.fromhex(f.readline())
         ecc_data = bytes.fromhex(f.readline())
 
         ecc_key = ECC.import_key(ecc_data)
+    return encrypt_key, hmac_key, ecc_key
+
+
+def bass_chunks(fp, length):
+    # The firmware after the BASS transform, CHUNK_SIZE bytes at a time
+    for chunk in read_chunks(fp, length):
+        # Do stupid stuff before encryption here!
+        yield ssb.bass(chunk)
+
+
+def package(keys, chunks, firmware_length, outfile, version, message):
+    # Encrypts and signs chunks of firmware that already went through ssb.bass, returns the signature
+    encrypt_key, hmac_key, ecc_key = keys
 
     hmac_obj = HMAC.new(hmac_key, digestmod=SHA256)
 
     # Allocate one flash block to message that goes before firmware
     m = message.encode()
-    m_pad = m + b'\xff' * (1024 - len(m))
 
-    # Shorts required but pack into ints instead
     # don't use the padded firmware length use normal length
-    metadata = p32(version, endian='little') + p32(len(firmware), endian='little') + \
-               p32(len(m), endian='little') + p32(0, endian='little')
-
-    hmac_obj.update(metadata)
+    hmac_obj.update(ssb.metadata(version, firmware_length, len(m)))
     metadata_hmac = hmac_obj.digest()
 
     #iv = os.urandom(16)
-    to_encrypt = metadata + metadata_hmac + m_pad + firmware_padded
     cipher = AES.new(encrypt_key, AES.MODE_CTR)
     iv = cipher.nonce + b'\x00' * 8
     #print(iv)
 
-    encrypted_blob = cipher.encrypt(to_encrypt)
+    signer = StreamSigner(ecc_key)
 
-    signer = eddsa.new(ecc_key, 'rfc8032')
-    signature = signer.sign(encrypted_blob)
+    with open(outfile, "wb+") as out:
+        # Room for the signature, filled in once everything after it is written
+        out.write(ssb.header(bytes(SIGNATURE_SIZE), iv))
+        blob_start = out.tell()
+
+        def write(data):
+            encrypted = cipher.encrypt(data)
+            signer.update(encrypted)
+            out.write(encrypted)
+
+        write(ssb.plaintext_header(version, firmware_length, m, metadata_hmac))
+
+        offset = 0
+        for chunk in chunks:
+            offset += len(chunk)
+            # Only the last chunk can be short, pad() makes it a whole number of blocks
+            if offset == firmware_length:
+                chunk = pad(chunk, 16)
+            write(chunk)
+        if firmware_length == 0:
+            write(pad(b'', 16))
+
+        blob_length = out.tell() - blob_start
+        out.seek(blob_start)
+        signature = signer.sign(read_chunks(out, blob_length))
+        out.seek(2)
+        out.write(signature)
+    return signature
+
+
+def protect_firmware(infile, outfile, version, message, secrets):
+    keys = load_secrets(secrets)
+    with open(infile, "rb") as fp:
+        firmware_length = os.fstat(fp.fileno()).st_size
+        signature = package(keys, bass_chunks(fp, firmware_length), firmware_length, outfile, version, message)
 
     print(signature.hex())
     print(len(signature))
 
-    #signature gets sent in at the end in seperate block
-    firmware_blob = p16(len(signature), endian='little') + signature + iv + encrypted_blob
 
-    # Write firmware blob to outfile
-    with open(outfile, "wb+") as outfile:
-        outfile.write(firmware_blob)
+# Keys of a batch worker process, loaded once by protect_worker_init
+worker_keys = None
+
+
+def protect_worker_init(secrets):
+    global worker_keys
+    worker_keys = load_secrets(secrets)
+
+
+def protect_worker(transformed, firmware_length, entry):
+    with open(transformed, "rb") as fp:
+        return package(worker_keys, read_chunks(fp, firmware_length), firmware_length,
+                       entry["outfile"], int(entry["version"]), entry["message"])
+
+
+def protect_batch(infile, manifest, secrets, jobs=None):
+    """
+    Packages every entry of manifest, a JSON list of
+    {"version": 2, "message": "...", "outfile": "..."}, from the same image.
+    The BASS transform does not depend on the entry, so it runs once into a
+    temporary file. Encrypting and signing fans out over jobs processes (one
+    per CPU by default), each reading the secrets once.
+    """
+    with open(manifest, 'r') as f:
+        entries = json.load(f)
 
-def basscrypt(stuff):
-    key = b'bananaaa'
-    r = b''
-    for i in range(len(stuff)):
-        e = stuff[i] ^ key[i % 8]
-        r += int.to_bytes(e)
-    return bytes(r)
+    with tempfile.TemporaryDirectory() as tmp:
+        transformed = os.path.join(tmp, "firmware.bass")
+        with open(infile, "rb") as fp, open(transformed, "wb") as out:
+            firmware_length = os.fstat(fp.fileno()).st_size
+            for chunk in bass_chunks(fp, firmware_length):
+                out.write(chunk)
 
+        with ProcessPoolExecutor(max_workers=jobs, initializer=protect_worker_init, initargs=(secrets,)) as pool:
+            signatures = pool.map(protect_worker, repeat(transformed), repeat(firmware_length), entries)
+            for entry, signature in zip(entries, signatures):
+                print(f"{entry['outfile']}: {signature.hex()}")
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Firmware Update Tool")
     parser.add_argument("--infile", help="Path to the firmware image to protect.", required=True)
-    parser.add_argument("--outfile", help="Filename for the output firmware.", required=True)
-    parser.add_argument("--version", help="Version number of this firmware.", required=True)
-    parser.add_argument("--message", help="Release message for this firmware.", required=True)
+    parser.add_argument("--outfile", help="Filename for the output firmware.")
+    parser.add_argument("--version", help="Version number of this firmware.")
+    parser.add_argument("--message", help="Release message for this firmware.")
     parser.add_argument("--secrets", help="File containing secrets", required=False)
+    parser.add_argument("--manifest", help="JSON list of version, message and outfile entries to package instead.")
+    parser.add_argument("--jobs", help="Processes for --manifest, one per CPU by default.", type=int)
     args = parser.parse_args()
 
-    protect_firmware(infile=args.infile, outfile=args.outfile, version=int(args.version), message=args.message, secrets=args.secrets)
+    if args.manifest:
+        protect_batch(infile=args.infile, manifest=args.manifest, secrets=args.secrets, jobs=args.jobs)
+    elif args.outfile is None or args.version is None or args.message is None:
+        parser.error("--outfile, --version and --message are required without --manifest")
+    else:
+        protect_firmware(infile=args.infile, outfile=args.outfile, version=int(args.version), message=args.message, secrets=args.secrets)
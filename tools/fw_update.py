@@ -20,183 +20,311 @@ In our case, the data is from one line of the Intel Hex formated .hex file
 We write a frame to the bootloader, then wait for it to respond with an
 OK message so we can write the next frame. The OK message in this case is
 just a zero
+
+If the bootloader accepts a window larger than one during the handshake, up to
+that many firmware frames are sent without waiting and every OK is followed by
+a one byte sequence number of the frame it acknowledges
+
+Before the window request the updater may propose a faster baud rate. Both
+sides switch, the updater sends a probe frame, each side answers with an OK
+and the bootloader confirms the updater's OK with an R. If any step times out
+both sides fall back to 115200. If only the R is lost the bootloader stays at
+the new rate, resets on the garbled instruction that follows and the update
+is started over
+
+Every frame goes out in one write. Responses are read with a selector as they
+arrive and scanned for the byte we expect, anything before it is the
+bootloader's debug text. Each response has its own timeout. The bootloader
+resets on a bad frame and cannot take a frame again, so after a timeout the
+whole update is started over, up to RETRIES times
 """
 
 import argparse
+from collections import namedtuple
 from pwn import *
+import os
+import selectors
 import time
 import serial
 
 from util import *
+import ssb
 
 
-ser = ""
-
 RESP_OK = b"A"
 RESP_UPDATE = b"U"
 SEND_UPDATE = b"U"
 SEND_FRAME = b"F"
+SEND_WINDOW = b"W"
+RESP_WINDOW = b"W"
+SEND_BAUD = b"R"
+RESP_BAUD = b"R"
 
-SIGNATURE_SIZE = 64
 FRAME_SIZE = 1024
-DEBUG = True
-
-SIZE_SIG = 72
-SIZE_IV = 16
-SIZE_METADATA = 16
-SIZE_HMAC = 32
-
-
-# calculates a crc 16- IBM checksum, becasue board had that funcitonality
-def calc_checksum(data): 
-    poly = 0xA001
-    crc = 0x0000
-    for byte in data:
-        crc ^= byte
-
-        for j in range(8):
-            if crc & 1:
-                crc = (crc >> 1) ^ poly
-            else:
-                crc >>= 1
-
-    return p16(crc & 0xFFFF, endian="little")
-
-def wait_confirmation(response):
-    print("Waiting for bootloader response....")
-    b = ser.read(1)
-    if DEBUG:
-        print(b.decode(), end='')
-    while b != response:
-        b = ser.read(1)
-        if DEBUG:
-            print(b.decode(), end='')
-        pass
-    print()
-    print(">")
 
+# frames in flight during a windowed update, the bootloader may accept fewer
+WINDOW_SIZE = 2
+
+# link speed, the bootloader always starts at DEFAULT_BAUD and may refuse the proposal
+DEFAULT_BAUD = 115200
+BAUD_RATE = 921600
+BAUD_PROBE = bytes(range(16))
+# longer than the bootloader's probe timeouts together, so when we give up it has too
+BAUD_PROBE_TIMEOUT = 1.5
+
+# seconds to wait for each response, the slowest is the signature check after the last frame
+RESPONSE_TIMEOUT = 5
+# times a timed out update is started over
+RETRIES = 2
+# a reset bootloader greets again, the link is quiet once it is done
+RESYNC_QUIET = 0.5
+RESYNC_TIMEOUT = 5
+
+
+class LinkTimeout(RuntimeError):
+    pass
+
+
+# A protected firmware split up for sending, the firmware is already in frames
+Package = namedtuple("Package", ["signature", "iv", "metadata", "metadata_hmac", "frames", "firmware_size"])
+
+
+class Link:
+    """
+    Non-blocking transport to the bootloader over an open serial port
+
+    Bytes are read as soon as the selector says the port has some and kept in
+    rx until a response is expected, so no read waits for a byte count.
+    """
+
+    def __init__(self, ser, debug=False, timeout=RESPONSE_TIMEOUT):
+        self.ser = ser
+        self.fd = ser.fileno()
+        self.debug = debug
+        self.timeout = timeout
+        self.rx = bytearray()
+        self.selector = selectors.DefaultSelector()
+        self.selector.register(self.fd, selectors.EVENT_READ)
 
-def send_metadata(ser, metadata, IV, metadata_hmac, debug=False):
+    def send(self, data):
+        self.ser.write(data)
+
+    def log(self, message):
+        print(message)
+
+    def progress(self, acked, frames):
+        # Called after every acknowledged firmware frame
+        pass
+
+    def fill(self, deadline):
+        # Adds whatever the port has to rx, waiting until deadline for at least one byte
+        remaining = deadline - time.monotonic()
+        if remaining <= 0 or not self.selector.select(remaining):
+            raise LinkTimeout("bootloader did not respond in time")
+        try:
+            data = os.read(self.fd, 4096)
+        except BlockingIOError:
+            return
+        except OSError as e:
+            raise RuntimeError(f"bootloader link closed: {e}")
+        if not data:
+            raise RuntimeError("bootloader link closed")
+        self.rx += data
+
+    def expect(self, response, timeout=None):
+        # Consumes rx up to and including the response byte, the bytes before it are debug text
+        deadline = time.monotonic() + (self.timeout if timeout is None else timeout)
+        while True:
+            i = self.rx.find(response)
+            if i >= 0:
+                break
+            self.fill(deadline)
+        if self.debug and i:
+            self.log(self.rx[:i].decode(errors="replace"))
+        del self.rx[:i + 1]
+
+    def read(self, size, timeout=None):
+        deadline = time.monotonic() + (self.timeout if timeout is None else timeout)
+        while len(self.rx) < size:
+            self.fill(deadline)
+        data = bytes(self.rx[:size])
+        del self.rx[:size]
+        return data
+
+    def drain(self, quiet, timeout):
+        # Drops everything until the port has been quiet for quiet seconds
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            try:
+                self.fill(min(deadline, time.monotonic() + quiet))
+            except LinkTimeout:
+                break
+        self.rx.clear()
+
+    def resync(self):
+        # Puts a bootloader in any state of an update back at its prompt. A frame in
+        # progress is filled with 0xff and fails its CRC, a bootloader waiting for a
+        # frame gets one of 0xffff bytes and fails the size check. Both reset it, and
+        # neither 0xff nor a frame instruction does anything at the prompt
+        self.ser.baudrate = DEFAULT_BAUD
+        self.send(b"\xff" * (FRAME_SIZE + 2) + SEND_FRAME + b"\xff\xff")
+        self.drain(RESYNC_QUIET, RESYNC_TIMEOUT)
+
+
+def build_frame(data):
+    return ssb.frame(data)
+
+def negotiate_baud(link, baud):
+    link.send(SEND_BAUD + p32(baud, endian="little"))
+    link.expect(RESP_BAUD)
+    baud = u32(link.read(4), endian="little")
+    if baud == DEFAULT_BAUD:
+        link.log(f"Bootloader stays at {DEFAULT_BAUD} baud")
+        return DEFAULT_BAUD
+
+    link.ser.flush()
+    link.ser.baudrate = baud
+    link.send(build_frame(BAUD_PROBE))
+
+    # Wait for the bootloader's OK at the new rate, answer with our own and wait for it to confirm
+    deadline = time.monotonic() + BAUD_PROBE_TIMEOUT
+    try:
+        link.expect(RESP_OK, timeout=BAUD_PROBE_TIMEOUT)
+        link.send(RESP_OK)
+        deadline = time.monotonic() + BAUD_PROBE_TIMEOUT
+        link.expect(RESP_BAUD, timeout=BAUD_PROBE_TIMEOUT)
+    except LinkTimeout:
+        time.sleep(max(0, deadline - time.monotonic()))
+        link.ser.baudrate = DEFAULT_BAUD
+        link.ser.reset_input_buffer()
+        link.rx.clear()
+        baud = DEFAULT_BAUD
+
+    link.log(f"Link running at {baud} baud")
+    return baud
+
+def send_metadata(link, metadata, IV, metadata_hmac, window=1, baud=DEFAULT_BAUD):
     # blob =  iv 16 | metadata version 4 | fw length 4 | len message 4 | pad 4 | meta data hmac 32
     assert(len(metadata) == 16)
 
-    # Might want to remove after debugging
-    print("Version: {???}\nFirmware is: {???} bytes\n message is {???} bytes \n")
-
     # Handshake for update
-    ser.write(SEND_UPDATE)
-    wait_confirmation(RESP_UPDATE)
-    
+    link.send(SEND_UPDATE)
+    link.expect(RESP_UPDATE)
 
-    if DEBUG:
-        print("Writing metadata")
+    if baud != DEFAULT_BAUD:
+        negotiate_baud(link, baud)
 
-    # Bootloader is now ready to accept metadata, send handshake
-    ser.write(SEND_FRAME)
+    # Ask for a window, the bootloader answers with the window it will use
+    if window > 1:
+        link.send(SEND_WINDOW + p8(window))
+        link.expect(RESP_WINDOW)
+        window = u8(link.read(1))
+        link.log(f"Bootloader accepted a window of {window} frames")
 
-    size = p16(64, endian="little") 
-    
-    # calculate a checksum please
-    frame_data = IV + metadata + metadata_hmac
-    checksum = calc_checksum(frame_data)
-    print(calc_checksum(b'sob'))
-    ser.write(size + frame_data + checksum)
+    if link.debug:
+        link.log("Writing metadata")
 
-    #ser.write(size + IV + metadata + metadata_hmac + calc_checksum(IV + metadata + metadata_hmac)) # last bits to take place of check
+    # Bootloader is now ready to accept metadata
+    link.send(build_frame(IV + metadata + metadata_hmac))
 
     # Wait for an OK from the bootloader.
-    wait_confirmation(RESP_OK)
-    if DEBUG:
-        print("Received confirmation :D")
-
-    # if resp != RESP_OK:  
-    #     raise RuntimeError("ERROR: Bootloader responded with {}".format(repr(resp)))
-def send_firmware(firmware, signature):
-    full_blocks = len(firmware) // 1024
-    extra = len(firmware) % 1024
-    for i in range(full_blocks):
-        if DEBUG:
-            print("Writing firmware frame!")
-        firmware_chunk = firmware[i * 1024: (i + 1) * 1024]
-        checksum = calc_checksum(firmware_chunk) # checksum is of only the (cyrpt) firmware chunk
-        ser.write(SEND_FRAME)
-        size = p16(1024, endian="little")
-        ser.write(size + firmware_chunk + checksum)  
-        print(f'The check is {checksum}')
-        wait_confirmation(RESP_OK)
-    if extra:
-        print("Writing partial frame!")
-        ser.write(SEND_FRAME)
-        size = p16(extra)
-        firmware_chunk = firmware[full_blocks * 1024:]
-        checksum = calc_checksum(firmware_chunk)
-        ser.write(size + firmware_chunk + checksum)
-        wait_confirmation(RESP_OK)
-    
-
-    print("Sending in signature please pray for me")
-    ser.write(SEND_FRAME)
-
-    ser.write(p16(0) + signature)
-    wait_confirmation(RESP_OK)
-
-
-def send_frame(ser, frame, debug=False):
-    ser.write(frame)  # Write the frame...
-
-    if debug:
-        print_hex(frame)
-
-    resp = ser.read(1)  # Wait for an OK from the bootloader
-
-    time.sleep(0.1)
-
-    if resp != RESP_OK:
-        raise RuntimeError("ERROR: Bootloader responded with {}".format(repr(resp)))
-
-    if debug:
-        print("Resp: {}".format(ord(resp)))
-
-
-def update(ser, infile, debug):
-    # Open serial port. Set baudrate to 115200. Set timeout to 2 seconds.
+    link.expect(RESP_OK)
+    if link.debug:
+        link.log("Received confirmation :D")
+    return window
+
+def send_signature(link, signature):
+    # The signature goes first so the bootloader can check the firmware while it is flashed
+    if link.debug:
+        link.log("Sending in signature please pray for me")
+    link.send(build_frame(signature))
+    link.expect(RESP_OK)
+
+def send_end(link):
+    # Zero length frame, the bootloader answers once the signature checks out
+    link.send(SEND_FRAME + p16(0, endian="little"))
+    link.expect(RESP_OK)
+
+def send_firmware_windowed(link, frames, window):
+    sent = 0
+    acked = 0
+    while acked < len(frames):
+        # Keep the window full, the bootloader receives the next frame while flashing the last one
+        while sent < len(frames) and sent - acked < window:
+            if link.debug:
+                link.log(f"Writing firmware frame {sent}!")
+            link.send(frames[sent])
+            sent += 1
+
+        link.expect(RESP_OK)
+        seq = u8(link.read(1))
+        if seq != acked & 0xFF:
+            raise RuntimeError(f"ERROR: Bootloader acknowledged frame {seq}, expected {acked & 0xFF}")
+        acked += 1
+        link.progress(acked, len(frames))
+
+    # Every frame is acknowledged so the bootloader is waiting for the end of the package
+    send_end(link)
+
+
+def send_firmware(link, frames):
+    for i, frame in enumerate(frames):
+        if link.debug:
+            link.log("Writing firmware frame!")
+        link.send(frame)
+        link.expect(RESP_OK)
+        link.progress(i + 1, len(frames))
+
+    send_end(link)
+
+
+def send_package(link, package, window, baud):
+    window = send_metadata(link, package.metadata, package.iv, package.metadata_hmac, window=window, baud=baud)
+    send_signature(link, package.signature)
+    if window > 1:
+        send_firmware_windowed(link, package.frames, window)
+    else:
+        send_firmware(link, package.frames)
+
+
+def read_package(infile):
     with open(infile, "rb") as fp:
         firmware_blob = fp.read()
 
+    # ssb.parse refuses a signature that is not the bootloader's length
+    signature, iv, data = ssb.parse(firmware_blob)
+    sig_len = len(signature)
+    print(f"Signature is {sig_len} bytes")
 
-    # firmware_blob = signature 32  iv 16  metadata 16  metadata_hmac 32  m_pad  firmware (numbers in bytes)
-    #
-    # Extracts each portion of the firmware blob
-    """
-    signature = firmware_blob[0:32]
-    iv = firmware_blob[32:48]  
-    metadata = firmware_blob[48:64]
-    metadata_hmac = firmware_blob[64:96]
-    firmware = firmware_blob[96:]
+    # The encrypted data starts with the metadata and its HMAC, the rest is sent in frames
+    metadata_end = ssb.SIZES["METADATA"]
+    metadata = data[:metadata_end]
+    metadata_hmac = data[metadata_end : metadata_end + ssb.SIZES["HMAC"]]
+    firmware = data[metadata_end + ssb.SIZES["HMAC"]:]
 
-    fw_size = u32(metadata[4:8], endian="little")
-    """
-    cur = 2
-    #this is not sent to the bootloader, it is just useful for quickly changing signing schemes
-    SIZE_SIG = u16(firmware_blob[:2], endian = 'little')
-    print(f"Signature is {SIZE_SIG} bytes")
-    if SIZE_SIG != SIGNATURE_SIZE:
-        print("WARNING: Signature size mismatch!")
-    signature = firmware_blob[cur : cur + SIZE_SIG]
-    cur += SIZE_SIG
-    iv = firmware_blob[cur : cur + SIZE_IV]
-    cur += SIZE_IV
-    metadata = firmware_blob[cur: cur + SIZE_METADATA]
-    cur += SIZE_METADATA
-    metadata_hmac = firmware_blob[cur : cur + SIZE_HMAC]
-    cur += SIZE_HMAC
-    firmware = firmware_blob[cur:]
-
-
-    send_metadata(ser, metadata, iv, metadata_hmac, debug=debug)
-    send_firmware(firmware, signature)
-
-    print("Yay you did it :bangbang:")
+    # checksum is of only the (cyrpt) firmware chunk
+    frames = [build_frame(firmware[i : i + FRAME_SIZE]) for i in range(0, len(firmware), FRAME_SIZE)]
+    return Package(signature, iv, metadata, metadata_hmac, frames, len(firmware))
+
+
+def update_package(link, package, window=WINDOW_SIZE, baud=BAUD_RATE, retries=RETRIES):
+    # Returns the number of attempts the update took
+    for attempt in range(retries + 1):
+        try:
+            send_package(link, package, window, baud)
+            break
+        except LinkTimeout as e:
+            if attempt == retries:
+                raise
+            link.log(f"{e}, starting the update again ({attempt + 1}/{retries})")
+            link.resync()
+
+    link.log("Yay you did it :bangbang:")
+    return attempt + 1
+
+
+def update(link, infile, window=WINDOW_SIZE, baud=BAUD_RATE, retries=RETRIES):
+    return update_package(link, read_package(infile), window=window, baud=baud, retries=retries)
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Firmware Update Tool")
@@ -204,13 +332,16 @@ if __name__ == "__main__":
     parser.add_argument("--port", help="Does nothing, included to adhere to command examples in rule doc", required=False)
     parser.add_argument("--firmware", help="Path to firmware image to load.", required=False)
     parser.add_argument("--debug", help="Enable debugging messages.", action="store_true")
+    parser.add_argument("--window", help="Firmware frames to keep in flight, 1 waits for every frame.", type=int, default=WINDOW_SIZE)
+    parser.add_argument("--baud", help="Baud rate to propose for the update, 115200 skips the negotiation.", type=int, default=BAUD_RATE)
+    parser.add_argument("--retries", help="Times to start a timed out update over.", type=int, default=RETRIES)
     args = parser.parse_args()
 
     if args.port == None:
-        ser = serial.Serial("/dev/ttyACM0", 115200)
+        ser = serial.Serial("/dev/ttyACM0", DEFAULT_BAUD)
     else:
 
-        ser = serial.Serial(args.port, 115200)
+        ser = serial.Serial(args.port, DEFAULT_BAUD)
 
-    update(ser=ser, infile=args.firmware, debug=args.debug)
+    update(link=Link(ser, debug=args.debug), infile=args.firmware, window=args.window, baud=args.baud, retries=args.retries)
     ser.close()
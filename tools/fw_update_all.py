@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+
+"""
+Parallel Firmware Updater
+
+Updates the bootloaders on a list of serial ports with the same protected
+firmware at once. The package is read and split into frames once, then every
+port gets its own thread running fw_update.py's update over its own Link, with
+the same response timeouts and retries as a single update.
+
+While the updates run a progress line with every device's acknowledged frames
+is printed each PROGRESS_INTERVAL seconds. At the end each device's result,
+attempts, time and throughput are printed along with the totals and every
+failure, and --json writes the same report to a file.
+
+--sim N starts N host simulators (make host in the bootloader directory) on
+fresh flash and EEPROM files and updates their ptys instead of --ports, so the
+updater can be run without boards.
+"""
+
+import argparse
+import json
+import os
+import pathlib
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor, wait
+
+import serial
+
+import fw_update
+
+REPO_ROOT = pathlib.Path(__file__).parent.parent.absolute()
+BOOTLOADER_DIR = os.path.join(REPO_ROOT, "bootloader")
+DEFAULT_SIM = os.path.join(BOOTLOADER_DIR, "sim/bin/bootloader_sim")
+DEFAULT_IMAGE = os.path.join(BOOTLOADER_DIR, "bin/bootloader.bin")
+
+PROGRESS_INTERVAL = 1
+SIM_START_TIMEOUT = 10
+
+# Lines from different devices' threads are printed whole
+print_lock = threading.Lock()
+
+
+def say(message):
+    with print_lock:
+        print(message, flush=True)
+
+
+class Device:
+    """One board being updated, written by its thread and read by the progress line and report"""
+
+    def __init__(self, port):
+        self.port = port
+        self.state = "waiting"
+        self.acked = 0
+        self.frames = 0
+        self.attempts = 0
+        self.seconds = 0
+        self.error = None
+
+
+class DeviceLink(fw_update.Link):
+    """fw_update.py's link, labelling its messages with the port and keeping the device's progress"""
+
+    def __init__(self, ser, device, debug=False):
+        super().__init__(ser, debug=debug)
+        self.device = device
+
+    def log(self, message):
+        say(f"{self.device.port}: {message}")
+
+    def progress(self, acked, frames):
+        self.device.acked = acked
+        self.device.frames = frames
+
+    def resync(self):
+        self.device.attempts += 1
+        self.device.acked = 0
+        super().resync()
+
+
+def update_device(device, package, args):
+    device.state = "updating"
+    device.attempts = 1
+    start = time.perf_counter()
+    try:
+        with serial.Serial(device.port, fw_update.DEFAULT_BAUD) as ser:
+            link = DeviceLink(ser, device, debug=args.debug)
+            # A bootloader that just reset greets with a line that has a 'U' in it
+            link.drain(fw_update.RESYNC_QUIET, fw_update.RESYNC_TIMEOUT)
+            start = time.perf_counter()
+            fw_update.update_package(link, package, window=args.window, baud=args.baud, retries=args.retries)
+        device.state = "ok"
+    except Exception as e:
+        # An exception left in the future would leave the device "updating" with no error in the report
+        device.state = "failed"
+        device.error = str(e) or type(e).__name__
+        say(f"{device.port}: FAILED {device.error}")
+    device.seconds = time.perf_counter() - start
+
+
+def progress_line(devices):
+    parts = []
+    for d in devices:
+        if d.state == "updating":
+            parts.append(f"{d.port} {d.acked}/{d.frames or '?'}")
+        else:
+            parts.append(f"{d.port} {d.state}")
+    return "progress: " + ", ".join(parts)
+
+
+def update_all(ports, package, args):
+    devices = [Device(port) for port in ports]
+    start = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=args.jobs or len(devices)) as pool:
+        futures = [pool.submit(update_device, d, package, args) for d in devices]
+        while wait(futures, timeout=PROGRESS_INTERVAL).not_done:
+            say(progress_line(devices))
+    return devices, time.perf_counter() - start
+
+
+def report(devices, elapsed, package):
+    ok = [d for d in devices if d.state == "ok"]
+    results = [{
+        "port": d.port,
+        "ok": d.state == "ok",
+        "attempts": d.attempts,
+        "seconds": d.seconds,
+        "bytes_per_s": package.firmware_size / d.seconds if d.state == "ok" and d.seconds else 0,
+        "error": d.error,
+    } for d in devices]
+    summary = {
+        "devices": len(devices),
+        "updated": len(ok),
+        "failed": len(devices) - len(ok),
+        "firmware_size": package.firmware_size,
+        "seconds": elapsed,
+        "bytes_per_s": package.firmware_size * len(ok) / elapsed if elapsed else 0,
+        "results": results,
+    }
+
+    width = max(len("port"), *(len(d.port) for d in devices))
+    print(f"{'port':<{width}} {'result':>7} {'attempts':>8} {'time s':>8} {'bytes/s':>10}")
+    for r in results:
+        print(f"{r['port']:<{width}} {'ok' if r['ok'] else 'FAILED':>7} {r['attempts']:>8} "
+              f"{r['seconds']:>8.2f} {r['bytes_per_s']:>10.0f}")
+    print(f"{len(ok)}/{len(devices)} devices updated in {elapsed:.2f} s, "
+          f"{summary['bytes_per_s']:.0f} firmware bytes/s in total")
+    for r in results:
+        if not r["ok"]:
+            print(f"failed: {r['port']}: {r['error']}")
+    return summary
+
+
+def start_simulators(count, sim, image, workdir):
+    # Each simulator gets its own flash, EEPROM and pty, --image provisions it like a freshly flashed board
+    procs = []
+    ports = []
+    for i in range(count):
+        port = os.path.join(workdir, f"uart{i}")
+        with open(os.path.join(workdir, f"sim{i}.log"), "w") as log:
+            procs.append(subprocess.Popen([sim,
+                                           "--flash", os.path.join(workdir, f"flash{i}.bin"),
+                                           "--eeprom", os.path.join(workdir, f"eeprom{i}.bin"),
+                                           "--image", image,
+                                           "--uart", port], stdout=log, stderr=log))
+        ports.append(port)
+
+    deadline = time.time() + SIM_START_TIMEOUT
+    for i, (proc, port) in enumerate(zip(procs, ports)):
+        while not os.path.exists(port):
+            if proc.poll() is not None or time.time() > deadline:
+                stop_simulators(procs)
+                raise RuntimeError(f"simulator {i} did not start, see sim{i}.log in {workdir}")
+            time.sleep(0.01)
+    return procs, ports
+
+
+def stop_simulators(procs):
+    for proc in procs:
+        if proc.poll() is None:
+            proc.kill()
+        proc.wait()
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Parallel Firmware Update Tool")
+    parser.add_argument("--firmware", help="Path to the protected firmware to load.", required=True)
+    targets = parser.add_mutually_exclusive_group(required=True)
+    targets.add_argument("--ports", help="Serial ports of the boards to update.", nargs="+")
+    targets.add_argument("--sim", help="Start this many simulators and update them instead of --ports.", type=int)
+    parser.add_argument("--sim-path", help="Path to the simulator.", default=DEFAULT_SIM)
+    parser.add_argument("--image", help="Bootloader image with the secrets block, for --sim.", default=DEFAULT_IMAGE)
+    parser.add_argument("--sim-dir", help="Keep the simulators' files and logs here instead of a temporary directory.")
+    parser.add_argument("--jobs", help="Devices to update at once, all of them by default.", type=int)
+    parser.add_argument("--window", help="Firmware frames to keep in flight, 1 waits for every frame.", type=int, default=fw_update.WINDOW_SIZE)
+    parser.add_argument("--baud", help="Baud rate to propose for the update, 115200 skips the negotiation.", type=int, default=fw_update.BAUD_RATE)
+    parser.add_argument("--retries", help="Times to start a timed out update over, per device.", type=int, default=fw_update.RETRIES)
+    parser.add_argument("--debug", help="Print the bootloaders' debug text.", action="store_true")
+    parser.add_argument("--json", help="Also write the report to this file.")
+    args = parser.parse_args()
+
+    package = fw_update.read_package(args.firmware)
+
+    procs = []
+    with tempfile.TemporaryDirectory() as tmpdir:
+        try:
+            ports = args.ports or []
+            if args.sim:
+                workdir = args.sim_dir or tmpdir
+                os.makedirs(workdir, exist_ok=True)
+                procs, ports = start_simulators(args.sim, args.sim_path, args.image, workdir)
+            devices, elapsed = update_all(ports, package, args)
+        finally:
+            stop_simulators(procs)
+
+    summary = report(devices, elapsed, package)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(summary, f, indent=2)
+    sys.exit(0 if summary["failed"] == 0 else 1)
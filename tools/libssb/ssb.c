@@ -0,0 +1,200 @@
+#include <setjmp.h>
+#include <string.h>
+
+#include "bootloader.h"
+#include "metadata.h"
+#include "secrets.h"
+#include "computer.h"
+#include "bass.h"
+#include "bf.h"
+#include "crc16.h"
+#include "ssb.h"
+
+#include "driverlib/sysctl.h"
+#include "driverlib/uart.h"
+#include "uart/uart.h"
+
+// Order of the sizes ssb_sizes reports, tools/ssb.py has the same list
+enum SSB_SIZE {
+	SSB_SIZE_HEADER,
+	SSB_SIZE_PLAINTEXT_HEADER,
+	SSB_SIZE_SIGNATURE,
+	SSB_SIZE_IV,
+	SSB_SIZE_METADATA,
+	SSB_SIZE_HMAC,
+	SSB_SIZE_MESSAGE,
+	SSB_SIZE_FRAME,
+	SSB_SIZE_BASS_PROGRAM,
+	SSB_SIZES
+};
+
+/*
+ * What the VM calls on the board. A bad instruction resets the board, here it
+ * jumps back to the ssb_ call that ran the program, which returns -1. Only one
+ * program can run at a time per process.
+ */
+static jmp_buf ssb_reset;
+
+void SysCtlReset(void) {
+	longjmp(ssb_reset, 1);
+}
+
+bool UARTBusy(uint32_t ui32Base) {
+	return false;
+}
+
+void uart_write_str(uint8_t uart, char *str) {
+}
+
+// Layout constants for the bindings, an index past the end returns 0
+uint32_t ssb_sizes(uint32_t which) {
+	static const uint32_t sizes[SSB_SIZES] = {
+		SSB_HEADER_SIZE,
+		SSB_PLAINTEXT_HEADER_SIZE,
+		SECRETS_SIGNATURE_LENGTH,
+		SECRETS_IV_LEN,
+		sizeof(metadata),
+		SECRETS_HASH_LENGTH,
+		FLASH_PAGESIZE,
+		READ_BUFFER_SIZE,
+		MAX_BASS_SIZE
+	};
+
+	return which < SSB_SIZES ? sizes[which] : 0;
+}
+
+uint16_t ssb_crc16(const uint8_t *data, uint32_t len) {
+	return crc16(0, data, len);
+}
+
+// A frame as read_frame expects it, out needs len + SSB_FRAME_OVERHEAD bytes
+uint32_t ssb_frame(uint8_t *out, const uint8_t *data, uint16_t len) {
+	uint16_t checksum = crc16(0, data, len);
+
+	out[0] = FRAME;
+	out[1] = len & 0xFF;
+	out[2] = len >> 8;
+	memcpy(out + 3, data, len);
+	out[3 + len] = checksum & 0xFF;
+	out[4 + len] = checksum >> 8;
+	return len + SSB_FRAME_OVERHEAD;
+}
+
+// The metadata the HMAC covers, fw_length is the firmware before padding
+uint32_t ssb_metadata(uint8_t *out, uint32_t version, uint32_t fw_length, uint32_t message_length) {
+	metadata m = {version, fw_length, message_length, 0};
+
+	memcpy(out, &m, sizeof(m));
+	return sizeof(m);
+}
+
+// Everything the encrypted data starts with before the firmware
+uint32_t ssb_plaintext_header(uint8_t *out, uint32_t version, uint32_t fw_length, const uint8_t *message, uint32_t message_length, const uint8_t *hmac) {
+	uint8_t *page = out + sizeof(metadata) + SECRETS_HASH_LENGTH;
+
+	if (message_length > FLASH_PAGESIZE) {
+		return 0;
+	}
+	ssb_metadata(out, version, fw_length, message_length);
+	memcpy(out + sizeof(metadata), hmac, SECRETS_HASH_LENGTH);
+	memcpy(page, message, message_length);
+	memset(page + message_length, 0xFF, FLASH_PAGESIZE - message_length);
+	return SSB_PLAINTEXT_HEADER_SIZE;
+}
+
+// What goes in front of the encrypted data
+uint32_t ssb_header(uint8_t *out, const uint8_t *signature, const uint8_t *iv) {
+	out[0] = SECRETS_SIGNATURE_LENGTH & 0xFF;
+	out[1] = SECRETS_SIGNATURE_LENGTH >> 8;
+	memcpy(out + 2, signature, SECRETS_SIGNATURE_LENGTH);
+	memcpy(out + 2 + SECRETS_SIGNATURE_LENGTH, iv, SECRETS_IV_LEN);
+	return SSB_HEADER_SIZE;
+}
+
+// Offsets of the signature, IV and encrypted data of a protected firmware, -1 if it is malformed
+int ssb_parse(const uint8_t *blob, uint32_t len, uint32_t *signature, uint32_t *iv, uint32_t *data) {
+	if (len < SSB_HEADER_SIZE + SSB_PLAINTEXT_HEADER_SIZE ||
+			(blob[0] | (blob[1] << 8)) != SECRETS_SIGNATURE_LENGTH ||
+			(len - SSB_HEADER_SIZE) % SECRETS_ENCRYPTION_BLOCK_LENGTH) {
+		return -1;
+	}
+	*signature = 2;
+	*iv = 2 + SECRETS_SIGNATURE_LENGTH;
+	*data = SSB_HEADER_SIZE;
+	return 0;
+}
+
+// Runs an assembled BASS program with the same VM as the bootloader
+// Returns the program's exit code, or -1 if it would have reset the board
+int ssb_bass_program(const uint8_t *program, uint32_t program_len, uint8_t *out, uint32_t out_len, const uint8_t *in, uint32_t in_len, uint32_t *written) {
+	static computer_instruction slots[COMP_PROGRAM_SLOTS];
+	static computer_state state;
+
+	// Slots past the end of the program are zero, a bad instruction, like bass.c's padding
+	memset(slots, 0, sizeof(slots));
+	memcpy(slots, program, program_len < sizeof(slots) ? program_len : sizeof(slots));
+
+	memset(&state, 0, sizeof(state));
+	state.instructions = slots;
+	state.sys_write_buffer = out;
+	state.sys_write_remaining = out_len;
+	state.sys_read_buffer = (uint8_t *) in;
+	state.sys_read_remaining = in_len;
+
+	*written = 0;
+	if (setjmp(ssb_reset)) {
+		return -1;
+	}
+	uint8_t ret = computer_interpret_program(&state);
+	*written = out_len - state.sys_write_remaining;
+	return ret;
+}
+
+// The bootloader's Dumb Bass program over len bytes, it is its own inverse
+int ssb_bass(uint8_t *out, const uint8_t *in, uint32_t len) {
+	uint32_t written;
+
+	return ssb_bass_program(instructions, MAX_BASS_SIZE, out, len, in, len, &written);
+}
+
+// Runs a BASS program compiled to C by tools/basspiler.py, like ssb_bass_program
+int ssb_bass_compiled(uint8_t (*program)(computer_state *), uint8_t *out, uint32_t out_len, const uint8_t *in, uint32_t in_len, uint32_t *written) {
+	static computer_state state;
+
+	memset(&state, 0, sizeof(state));
+	state.sys_write_buffer = out;
+	state.sys_write_remaining = out_len;
+	state.sys_read_buffer = (uint8_t *) in;
+	state.sys_read_remaining = in_len;
+
+	*written = 0;
+	if (setjmp(ssb_reset)) {
+		return -1;
+	}
+	uint8_t ret = program(&state);
+	*written = out_len - state.sys_write_remaining;
+	return ret;
+}
+
+// src/bass_native.c over len bytes, what make BASS_NATIVE=1 runs instead of ssb_bass
+int ssb_bass_native(uint8_t *out, const uint8_t *in, uint32_t len) {
+	uint32_t written;
+
+	return ssb_bass_compiled(bass_native, out, len, in, len, &written);
+}
+
+// What the bootloader does to each key after reading it from EEPROM
+void ssb_bf_decrypt(uint8_t *key, uint8_t len) {
+	bf_decrypt(key, len);
+}
+
+// The EEPROM copy of a key, what special.sdo writes when bassterpreter.py runs it
+void ssb_bf_encrypt(uint8_t *out, const uint8_t *key, uint8_t len) {
+	for (uint8_t i = 0; i < len; i++) {
+		if (i & 1) {
+			out[i] = ((uint8_t) (i + 7) ^ key[i]) + 1;
+		} else {
+			out[i] = key[i] + 53 + i;
+		}
+	}
+}
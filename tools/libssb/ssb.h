@@ -0,0 +1,39 @@
+#ifndef __SSB_H__
+#define __SSB_H__
+#include <stdint.h>
+#include "computer.h"
+
+/*
+ * Host library for the tools (tools/ssb.py)
+ *
+ * The CRC, the BASS VM and program, the program as translated by basspiler.py
+ * and the BF key program are the bootloader's own sources compiled for the
+ * host, and the package layout comes from its headers, so the tools and the
+ * board can't disagree about them.
+ *
+ * A protected firmware is
+ *     | signature length (2) | signature | IV | encrypted data |
+ * and the encrypted data is
+ *     | metadata | HMAC of metadata | message, 0xff padded to a page | firmware, PKCS7 padded |
+ */
+
+#define SSB_HEADER_SIZE (2 + SECRETS_SIGNATURE_LENGTH + SECRETS_IV_LEN)
+#define SSB_PLAINTEXT_HEADER_SIZE (sizeof(metadata) + SECRETS_HASH_LENGTH + FLASH_PAGESIZE)
+// Frame instruction, length and CRC around the data
+#define SSB_FRAME_OVERHEAD 5
+
+uint32_t ssb_sizes(uint32_t which);
+uint16_t ssb_crc16(const uint8_t *data, uint32_t len);
+uint32_t ssb_frame(uint8_t *out, const uint8_t *data, uint16_t len);
+uint32_t ssb_metadata(uint8_t *out, uint32_t version, uint32_t fw_length, uint32_t message_length);
+uint32_t ssb_plaintext_header(uint8_t *out, uint32_t version, uint32_t fw_length, const uint8_t *message, uint32_t message_length, const uint8_t *hmac);
+uint32_t ssb_header(uint8_t *out, const uint8_t *signature, const uint8_t *iv);
+int ssb_parse(const uint8_t *blob, uint32_t len, uint32_t *signature, uint32_t *iv, uint32_t *data);
+int ssb_bass_program(const uint8_t *program, uint32_t program_len, uint8_t *out, uint32_t out_len, const uint8_t *in, uint32_t in_len, uint32_t *written);
+int ssb_bass(uint8_t *out, const uint8_t *in, uint32_t len);
+int ssb_bass_compiled(uint8_t (*program)(computer_state *), uint8_t *out, uint32_t out_len, const uint8_t *in, uint32_t in_len, uint32_t *written);
+int ssb_bass_native(uint8_t *out, const uint8_t *in, uint32_t len);
+void ssb_bf_decrypt(uint8_t *key, uint8_t len);
+void ssb_bf_encrypt(uint8_t *out, const uint8_t *key, uint8_t len);
+
+#endif
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+
+"""
+Checks libssb and ssb.py against the code they stand in for, run with
+
+    make -C libssb test
+
+crc16: the bootloader's crc16.c (through libssb) and both versions of
+ssb.crc16 against driverlib's sw_crc.c Crc16, the software version of
+ROM_Crc16, over random data, lengths, alignments and running CRCs.
+
+bass: basspiler.py against bassterpreter.py. src/bass_native.c has to be what
+basspiler makes of bananaaa.dumbbass and give the same output as bassterpreter
+and the board's VM. Random programs are translated, compiled with CC and run
+the same way. They only use the instructions bassterpreter and the board's VM
+agree on, which leaves out CMP, JNE, JLT and NOT (see ssb.py).
+"""
+
+import contextlib
+import ctypes
+import io
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(HERE, ".."))
+import ssb
+import basscodes
+import bassterpreter
+from bassembler import assemble
+from basspiler import translate
+
+TOOLS = os.path.join(HERE, "..")
+BOOTLOADER = os.path.join(TOOLS, "..", "bootloader")
+LIB = os.path.join(TOOLS, "..", "lib")
+CC = os.environ.get("CC", "cc")
+
+CRC16_RUNS = 20000
+CRC16_MAX_LEN = 2 * ssb.SIZES["FRAME"]
+
+BASS_RUNS = 200
+BASS_MAX_LEN = 256
+BASS_PROGRAMS = 300
+BASS_PROGRAM_LEN = 40
+# Enough for what the program writes along the way and the registers and memory at the end
+BASS_MAX_OUT = 512
+# Steps before bassterpreter gives up, the random programs only jump forward
+BASS_MAX_STEPS = 1 << 20
+
+REGISTERS = [basscodes.COMP_RA_MASK, basscodes.COMP_RB_MASK, basscodes.COMP_RC_MASK,
+             basscodes.COMP_RD_MASK, basscodes.COMP_RE_MASK, basscodes.COMP_RF_MASK]
+REG_OPS = [basscodes.COMP_MOV_CODE, basscodes.COMP_ADD_CODE, basscodes.COMP_SUB_CODE,
+           basscodes.COMP_STM_CODE, basscodes.COMP_LDM_CODE, basscodes.COMP_AND_CODE,
+           basscodes.COMP_ORR_CODE, basscodes.COMP_XOR_CODE]
+SYSCODES = [basscodes.COMP_SYS_READ, basscodes.COMP_SYS_WRITE, basscodes.COMP_SYS_READ_BLOCK,
+            basscodes.COMP_SYS_WRITE_BLOCK, basscodes.COMP_SYS_XOR_BLOCK]
+
+
+def load(name):
+    return ctypes.CDLL(os.path.join(HERE, "bin", name))
+
+
+def crc16_at(fn, seed, buf, offset, length):
+    return fn(seed, ctypes.byref(buf, offset), length)
+
+
+def test_crc16(rng):
+    if not ssb.NATIVE:
+        raise RuntimeError("libssb is not built")
+    reference = load("libswcrc.so").Crc16
+    crc16 = ssb.lib.crc16
+    for fn in (reference, crc16):
+        fn.argtypes = [ctypes.c_uint16, ctypes.c_void_p, ctypes.c_uint32]
+        fn.restype = ctypes.c_uint16
+
+    for run in range(CRC16_RUNS):
+        length = rng.randrange(CRC16_MAX_LEN + 1)
+        offset = rng.randrange(8)
+        seed = rng.randrange(0x10000) if run % 2 else 0
+        data = rng.randbytes(length)
+        buf = ctypes.create_string_buffer(offset + length + 8)
+        ctypes.memmove(ctypes.byref(buf, offset), data, length)
+
+        # Crc16 reads a byte before checking the length when the buffer is odd, the CRC of nothing is the seed
+        want = crc16_at(reference, seed, buf, offset, length) if length else seed
+        got = crc16_at(crc16, seed, buf, offset, length)
+        if got != want:
+            raise AssertionError(f"crc16.c gave {got:#06x}, Crc16 {want:#06x} (length {length}, offset {offset}, seed {seed:#06x})")
+        if seed:
+            continue
+
+        native = ssb.crc16(data)
+        ssb.NATIVE = False
+        python = ssb.crc16(data)
+        ssb.NATIVE = True
+        if native != want or python != want:
+            raise AssertionError(f"ssb.crc16 gave {native:#06x} native and {python:#06x} in Python, Crc16 {want:#06x} (length {length})")
+    print(f"crc16: {CRC16_RUNS} buffers match Crc16")
+
+
+def interpret(program, data, out_len):
+    # What bassterpreter.py writes, it prints why it stopped
+    written = []
+    state = bassterpreter.State(program, written, data, len(data), out_len)
+    with contextlib.redirect_stdout(io.StringIO()):
+        for _ in range(BASS_MAX_STEPS):
+            if state.interpret_instruction():
+                return bytes(written)
+    raise AssertionError("bassterpreter.py did not finish")
+
+
+def random_program(rng):
+    ins = []
+    for _ in range(BASS_PROGRAM_LEN):
+        kind = rng.random()
+        if kind < 0.5:
+            ins.append((rng.choice(REG_OPS), rng.choice(REGISTERS), rng.choice(REGISTERS)))
+        elif kind < 0.7:
+            ins.append((basscodes.COMP_IMM_CODE, rng.choice(REGISTERS), rng.randrange(256)))
+        elif kind < 0.9:
+            # ra picks the syscall, rb is the byte or length, a and b are memory addresses
+            ins.append((basscodes.COMP_IMM_CODE, basscodes.COMP_RA_MASK, rng.choice(SYSCODES)))
+            ins.append((basscodes.COMP_IMM_CODE, basscodes.COMP_RB_MASK, rng.randrange(1, 17)))
+            ins.append((basscodes.COMP_SYS_CODE, rng.randrange(256), rng.randrange(256)))
+        else:
+            ins.append((basscodes.COMP_JMP_CODE, len(ins) + rng.randrange(1, 4), 0))
+    # Jumps past the end land on the end, which writes rb to rf and all of memory out before exiting
+    end = len(ins)
+    ins = [(op, min(a, end), b) if op == basscodes.COMP_JMP_CODE else (op, a, b) for op, a, b in ins]
+    for reg in REGISTERS[1:]:
+        ins.append((basscodes.COMP_MOV_CODE, basscodes.COMP_RB_MASK, reg))
+        ins.append((basscodes.COMP_IMM_CODE, basscodes.COMP_RA_MASK, basscodes.COMP_SYS_WRITE))
+        ins.append((basscodes.COMP_SYS_CODE, 0, 0))
+    ins.append((basscodes.COMP_IMM_CODE, basscodes.COMP_RA_MASK, basscodes.COMP_SYS_WRITE_BLOCK))
+    ins.append((basscodes.COMP_IMM_CODE, basscodes.COMP_RB_MASK, 255))
+    ins.append((basscodes.COMP_SYS_CODE, 0, 0))
+    ins.append((basscodes.COMP_IMM_CODE, basscodes.COMP_RA_MASK, basscodes.COMP_SYS_EXIT))
+    ins.append((basscodes.COMP_SYS_CODE, 0, 0))
+    return bytes(byte for instruction in ins for byte in instruction)
+
+
+def compile_programs(programs, workdir):
+    # One library with each program's bass_native renamed to bass_random_<n>
+    source = os.path.join(workdir, "bass_random.c")
+    library = os.path.join(workdir, "bass_random.so")
+    with open(source, "w") as f:
+        for n, program in enumerate(programs):
+            f.write(translate(program, f"random program {n}").replace("bass_native(", f"bass_random_{n}("))
+    subprocess.run([CC, "-std=gnu99", "-O1", "-w", "-shared", "-fPIC",
+                    "-DBOOTLOADER_HOST", "-DPART_TM4C123GH6PM",
+                    f"-I{os.path.join(BOOTLOADER, 'inc')}", f"-I{LIB}",
+                    "-o", library, source,
+                    f"-L{os.path.join(HERE, 'bin')}", "-lssb", f"-Wl,-rpath,{os.path.join(HERE, 'bin')}"],
+                   check=True)
+    lib = ctypes.CDLL(library)
+    return [ctypes.cast(getattr(lib, f"bass_random_{n}"), ctypes.c_void_p).value for n in range(len(programs))]
+
+
+def test_bass(rng):
+    if not ssb.NATIVE:
+        raise RuntimeError("libssb is not built")
+    with open(os.path.join(TOOLS, "bananaaa.dumbbass")) as f:
+        program = assemble(f.readlines(), log=lambda *args: None)
+    with open(os.path.join(BOOTLOADER, "src", "bass_native.c")) as f:
+        if f.read() != translate(program, "bananaaa.dumbbass"):
+            raise AssertionError("src/bass_native.c is not basspiler.py's output for bananaaa.dumbbass, regenerate it")
+
+    for _ in range(BASS_RUNS):
+        data = rng.randbytes(rng.randrange(BASS_MAX_LEN + 1))
+        want = interpret(program, data, len(data))
+        native = ssb.bass_native(data)
+        vm = ssb.bass(data)
+        if native != want or vm != want:
+            raise AssertionError(f"bananaaa.dumbbass over {len(data)} bytes differs: bassterpreter {want.hex()}, "
+                                 f"native {native.hex()}, VM {vm.hex()}")
+    print(f"bass: bass_native.c matches bassterpreter.py on {BASS_RUNS} inputs")
+
+    programs = [random_program(rng) for _ in range(BASS_PROGRAMS)]
+    with tempfile.TemporaryDirectory() as workdir:
+        functions = compile_programs(programs, workdir)
+        for n, (program, function) in enumerate(zip(programs, functions)):
+            data = rng.randbytes(rng.randrange(64))
+            out_len = rng.randrange(BASS_MAX_OUT)
+            want = interpret(program, data, out_len)
+            native = ssb.bass_compiled(function, data, out_len)
+            vm = ssb.bass_program(program, data, out_len)
+            if native != want or vm != want:
+                raise AssertionError(f"random program {n} {program.hex()} differs: bassterpreter {want.hex()}, "
+                                     f"native {native.hex()}, VM {vm.hex()}")
+    print(f"bass: {BASS_PROGRAMS} random programs match bassterpreter.py")
+
+
+if __name__ == "__main__":
+    seed = int(sys.argv[1]) if len(sys.argv) > 1 else random.randrange(1 << 32)
+    print(f"seed {seed}")
+    rng = random.Random(seed)
+    test_crc16(rng)
+    test_bass(rng)
@@ -0,0 +1,224 @@
+#!/usr/bin/env python
+
+"""
+Bindings for libssb
+
+libssb (tools/libssb) is the bootloader's CRC, Dumb Bass VM and program, BF key
+program and package layout compiled for the host, so the tools use the code
+the board runs instead of their own copy of it. Build it with
+
+    make -C libssb
+
+When it has not been built the functions here fall back to Python versions of
+the same thing, except bass_program, bass_compiled, bass_native and bf_decrypt
+which only exist in C.
+NATIVE says which one is in use.
+
+bass_program is the board's VM, which is not bassterpreter.py: its JNE jumps
+when the zero flag is set and its NOT is a logical not. Programs written for
+one do not give the same output on the other, so special.sdo, which was written
+for bassterpreter.py, is bf_encrypt here instead of a program run on the VM.
+"""
+
+import ctypes
+import os
+import struct
+
+LIBRARY = os.path.join(os.path.dirname(os.path.abspath(__file__)), "libssb", "bin", "libssb.so")
+
+# ssb_sizes indices, in the order of enum SSB_SIZE in ssb.c
+SIZE_NAMES = ["HEADER", "PLAINTEXT_HEADER", "SIGNATURE", "IV", "METADATA", "HMAC", "MESSAGE", "FRAME", "BASS_PROGRAM"]
+
+FRAME = b"F"
+BASS_KEY = b"bananaaa"
+CRC16_POLY = 0xA001
+
+
+def load():
+    if not os.path.exists(LIBRARY):
+        return None
+    lib = ctypes.CDLL(LIBRARY)
+    u8p = ctypes.c_char_p
+    u32 = ctypes.c_uint32
+    u32p = ctypes.POINTER(ctypes.c_uint32)
+    lib.ssb_sizes.argtypes = [u32]
+    lib.ssb_sizes.restype = u32
+    lib.ssb_crc16.argtypes = [u8p, u32]
+    lib.ssb_crc16.restype = ctypes.c_uint16
+    lib.ssb_frame.argtypes = [u8p, u8p, ctypes.c_uint16]
+    lib.ssb_frame.restype = u32
+    lib.ssb_metadata.argtypes = [u8p, u32, u32, u32]
+    lib.ssb_metadata.restype = u32
+    lib.ssb_plaintext_header.argtypes = [u8p, u32, u32, u8p, u32, u8p]
+    lib.ssb_plaintext_header.restype = u32
+    lib.ssb_header.argtypes = [u8p, u8p, u8p]
+    lib.ssb_header.restype = u32
+    lib.ssb_parse.argtypes = [u8p, u32, u32p, u32p, u32p]
+    lib.ssb_parse.restype = ctypes.c_int
+    lib.ssb_bass_program.argtypes = [u8p, u32, u8p, u32, u8p, u32, u32p]
+    lib.ssb_bass_program.restype = ctypes.c_int
+    lib.ssb_bass.argtypes = [u8p, u8p, u32]
+    lib.ssb_bass.restype = ctypes.c_int
+    lib.ssb_bass_compiled.argtypes = [ctypes.c_void_p, u8p, u32, u8p, u32, u32p]
+    lib.ssb_bass_compiled.restype = ctypes.c_int
+    lib.ssb_bass_native.argtypes = [u8p, u8p, u32]
+    lib.ssb_bass_native.restype = ctypes.c_int
+    lib.ssb_bf_decrypt.argtypes = [u8p, ctypes.c_uint8]
+    lib.ssb_bf_decrypt.restype = None
+    lib.ssb_bf_encrypt.argtypes = [u8p, u8p, ctypes.c_uint8]
+    lib.ssb_bf_encrypt.restype = None
+    return lib
+
+
+lib = load()
+NATIVE = lib is not None
+
+if NATIVE:
+    SIZES = {name: lib.ssb_sizes(i) for i, name in enumerate(SIZE_NAMES)}
+else:
+    SIZES = {"HEADER": 82, "PLAINTEXT_HEADER": 1072, "SIGNATURE": 64, "IV": 16, "METADATA": 16,
+             "HMAC": 32, "MESSAGE": 1024, "FRAME": 1024, "BASS_PROGRAM": 768}
+
+
+def crc16_table():
+    table = []
+    for byte in range(256):
+        crc = byte
+        for j in range(8):
+            crc = (crc >> 1) ^ CRC16_POLY if crc & 1 else crc >> 1
+        table.append(crc)
+    return table
+
+
+CRC16_TABLE = crc16_table()
+
+
+def crc16(data):
+    """CRC-16/IBM of data, what read_frame checks"""
+    if NATIVE:
+        return lib.ssb_crc16(bytes(data), len(data))
+    crc = 0
+    for byte in data:
+        crc = (crc >> 8) ^ CRC16_TABLE[(crc ^ byte) & 0xFF]
+    return crc
+
+
+def frame(data):
+    """data as a frame: frame instruction, length, data and CRC"""
+    if NATIVE:
+        out = ctypes.create_string_buffer(len(data) + 5)
+        size = lib.ssb_frame(out, bytes(data), len(data))
+        return out.raw[:size]
+    return FRAME + struct.pack("<H", len(data)) + bytes(data) + struct.pack("<H", crc16(data))
+
+
+def metadata(version, fw_length, message_length):
+    """The metadata block the HMAC covers"""
+    if NATIVE:
+        out = ctypes.create_string_buffer(SIZES["METADATA"])
+        size = lib.ssb_metadata(out, version, fw_length, message_length)
+        return out.raw[:size]
+    return struct.pack("<IIII", version, fw_length, message_length, 0)
+
+
+def plaintext_header(version, fw_length, message, hmac):
+    """Metadata, its HMAC and the 0xff padded message, what the firmware follows before encryption"""
+    if NATIVE:
+        out = ctypes.create_string_buffer(SIZES["PLAINTEXT_HEADER"])
+        size = lib.ssb_plaintext_header(out, version, fw_length, message, len(message), hmac)
+        if size == 0:
+            raise ValueError("message does not fit in a flash page")
+        return out.raw[:size]
+    if len(message) > SIZES["MESSAGE"]:
+        raise ValueError("message does not fit in a flash page")
+    return metadata(version, fw_length, len(message)) + hmac + message + b"\xff" * (SIZES["MESSAGE"] - len(message))
+
+
+def header(signature, iv):
+    """Signature length, signature and IV, what the encrypted data follows"""
+    if NATIVE:
+        out = ctypes.create_string_buffer(SIZES["HEADER"])
+        size = lib.ssb_header(out, signature, iv)
+        return out.raw[:size]
+    return struct.pack("<H", SIZES["SIGNATURE"]) + signature + iv
+
+
+def parse(blob):
+    """Splits a protected firmware into its signature, IV and encrypted data"""
+    if NATIVE:
+        signature, iv, data = ctypes.c_uint32(), ctypes.c_uint32(), ctypes.c_uint32()
+        if lib.ssb_parse(blob, len(blob), signature, iv, data):
+            raise ValueError("not a protected firmware")
+        signature, iv, data = signature.value, iv.value, data.value
+    else:
+        signature, iv, data = 2, 2 + SIZES["SIGNATURE"], SIZES["HEADER"]
+        if (len(blob) < SIZES["HEADER"] + SIZES["PLAINTEXT_HEADER"] or
+                struct.unpack("<H", blob[:2])[0] != SIZES["SIGNATURE"] or (len(blob) - data) % 16):
+            raise ValueError("not a protected firmware")
+    return blob[signature:iv], blob[iv:data], blob[data:]
+
+
+def bass_program(program, data, out_len=None):
+    """Runs an assembled Dumb Bass program on the board's VM with data as its input, returns what it wrote"""
+    if not NATIVE:
+        raise RuntimeError("bass_program needs libssb, run make -C libssb")
+    if out_len is None:
+        out_len = len(data)
+    out = ctypes.create_string_buffer(out_len)
+    written = ctypes.c_uint32()
+    if lib.ssb_bass_program(program, len(program), out, out_len, bytes(data), len(data), written) < 0:
+        raise ValueError("Dumb Bass program hit a bad instruction")
+    return out.raw[:written.value]
+
+
+def bass_compiled(function, data, out_len=None):
+    """Runs a program compiled by basspiler.py, function is its address in a loaded library"""
+    if not NATIVE:
+        raise RuntimeError("bass_compiled needs libssb, run make -C libssb")
+    if out_len is None:
+        out_len = len(data)
+    out = ctypes.create_string_buffer(out_len)
+    written = ctypes.c_uint32()
+    if lib.ssb_bass_compiled(function, out, out_len, bytes(data), len(data), written) < 0:
+        raise ValueError("Dumb Bass program hit a bad instruction")
+    return out.raw[:written.value]
+
+
+def bass_native(data):
+    """bass with the program compiled by basspiler.py, what make BASS_NATIVE=1 runs"""
+    if not NATIVE:
+        raise RuntimeError("bass_native needs libssb, run make -C libssb")
+    out = ctypes.create_string_buffer(len(data))
+    if lib.ssb_bass_native(out, bytes(data), len(data)) < 0:
+        raise ValueError("Dumb Bass program hit a bad instruction")
+    return out.raw
+
+
+def bass(data):
+    """The bootloader's Dumb Bass program over data, it is its own inverse and restarts its key every 8 bytes"""
+    if NATIVE:
+        out = ctypes.create_string_buffer(len(data))
+        if lib.ssb_bass(out, bytes(data), len(data)) < 0:
+            raise ValueError("Dumb Bass program hit a bad instruction")
+        return out.raw
+    key = (BASS_KEY * (len(data) // len(BASS_KEY) + 1))[:len(data)]
+    return (int.from_bytes(data, "little") ^ int.from_bytes(key, "little")).to_bytes(len(data), "little")
+
+
+def bf_decrypt(key):
+    """What the bootloader does to a key after reading it from EEPROM"""
+    if not NATIVE:
+        raise RuntimeError("bf_decrypt needs libssb, run make -C libssb")
+    buf = ctypes.create_string_buffer(bytes(key), len(key))
+    lib.ssb_bf_decrypt(buf, len(key))
+    return buf.raw
+
+
+def bf_encrypt(key):
+    """The EEPROM copy of a key, what special.sdo gives on bassterpreter.py"""
+    if NATIVE:
+        out = ctypes.create_string_buffer(len(key))
+        lib.ssb_bf_encrypt(out, bytes(key), len(key))
+        return out.raw
+    return bytes(((((i + 7) & 0xff) ^ k) + 1) & 0xff if i & 1 else (k + 53 + i) & 0xff
+                 for i, k in enumerate(key))